@@ -0,0 +1,180 @@
+/**
+******************************************************************************
+*
+*  @file       strutil/batch.h
+*  @brief      In-place transforms over every string of a vector, optionally on several threads
+*
+******************************************************************************
+*/
+
+#pragma once
+
+#include "core.h"
+#include "text.h"
+#include "trim.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace strutil {
+/**
+ * @brief Built-in operations for strutil::transform_all. Each one modifies a std::string in place
+ *        and gives the same result as the strutil function of the same name.
+ */
+namespace ops {
+/**
+ * @brief Removes leading and trailing whitespace, as strutil::trim.
+ */
+struct trim {
+    void operator()(std::string& str) const {
+        strutil::trim(str);
+    }
+};
+
+/**
+ * @brief Converts to lower case, as strutil::to_lower, without allocating a new string.
+ */
+struct to_lower {
+    void operator()(std::string& str) const {
+        std::transform(str.begin(), str.end(), str.begin(), [](char c) {
+            return static_cast<char>(std::tolower(c));
+        });
+    }
+};
+
+/**
+ * @brief Converts to upper case, as strutil::to_upper, without allocating a new string.
+ */
+struct to_upper {
+    void operator()(std::string& str) const {
+        std::transform(str.begin(), str.end(), str.begin(), [](char c) {
+            return static_cast<char>(std::toupper(c));
+        });
+    }
+};
+
+/**
+ * @brief Replaces all occurrences of target with replacement, as strutil::replace_all.
+ */
+struct replace_all {
+    std::string target;
+    std::string replacement;
+
+    void operator()(std::string& str) const {
+        strutil::replace_all(str, target, replacement);
+    }
+};
+
+/**
+ * @brief Shortens strings longer than max_length and appends the ellipsis, as strutil::truncate.
+ */
+struct truncate {
+    std::size_t max_length = 100;
+    std::string ellipsis = "...";
+
+    void operator()(std::string& str) const {
+        if (str.size() <= max_length) {
+            return;
+        }
+        if (max_length <= ellipsis.size()) {
+            str.assign(ellipsis, 0, max_length);
+            return;
+        }
+        str.resize(max_length - ellipsis.size());
+        str.append(ellipsis);
+    }
+};
+} // namespace ops
+
+namespace detail {
+/**
+ * @brief Number of consecutive strings a worker of strutil::transform_all claims at a time. Large enough
+ *        that only the strings at chunk edges can share a cache line with another thread's strings,
+ *        small enough that threads that drew long strings do not hold up the others.
+ */
+inline constexpr std::size_t TRANSFORM_CHUNK_SIZE = 1024;
+} // namespace detail
+
+/**
+ * @brief Applies op to every string of strs in place. With several threads, workers repeatedly claim
+ *        the next chunk of consecutive strings from a shared counter until the vector is exhausted;
+ *        tools/bench_transform_all.cpp measures the speedup per thread count.
+ * @tparam Op - callable taking std::string&: either modifies it and returns void, or returns the new
+ *              value, e.g. strutil::ops::trim{} or [](const std::string& s) { return strutil::capitalize(s); }.
+ * @param strs - strings to transform.
+ * @param op - the operation; called concurrently from several threads when threads > 1.
+ * @param threads - number of threads transforming chunks of strs.
+ * @throws The first exception thrown by op (or by starting a thread), after all threads have been
+ *         joined; chunks not yet claimed are skipped, so strs may be partially transformed.
+ */
+template<typename Op>
+void transform_all(std::vector<std::string>& strs, const Op& op, unsigned threads = 1) {
+    const auto apply = [&op](std::string& str) {
+        if constexpr (std::is_void_v<std::invoke_result_t<const Op&, std::string&>>) {
+            op(str);
+        } else {
+            str = op(str);
+        }
+    };
+
+    const std::size_t chunks = (strs.size() + detail::TRANSFORM_CHUNK_SIZE - 1) / detail::TRANSFORM_CHUNK_SIZE;
+    threads = std::max(1u, std::min<unsigned>(threads, static_cast<unsigned>(chunks)));
+    if (threads == 1) {
+        for (auto& str : strs) {
+            apply(str);
+        }
+        return;
+    }
+
+    std::atomic<std::size_t> next_chunk{0};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    const auto fail = [&](std::exception_ptr exception) {
+        const std::lock_guard<std::mutex> lock(error_mutex);
+        if (!error) {
+            error = exception;
+        }
+        // no further chunks are claimed
+        next_chunk = chunks;
+    };
+    const auto work = [&]() {
+        try {
+            for (std::size_t chunk = next_chunk++; chunk < chunks; chunk = next_chunk++) {
+                const std::size_t end = std::min(strs.size(), (chunk + 1) * detail::TRANSFORM_CHUNK_SIZE);
+                for (std::size_t i = chunk * detail::TRANSFORM_CHUNK_SIZE; i < end; ++i) {
+                    apply(strs[i]);
+                }
+            }
+        } catch (...) {
+            fail(std::current_exception());
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    try {
+        for (unsigned t = 1; t < threads; ++t) {
+            workers.emplace_back(work);
+        }
+    } catch (...) {
+        fail(std::current_exception());
+    }
+    work();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+} // namespace strutil
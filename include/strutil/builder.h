@@ -0,0 +1,278 @@
+/**
+******************************************************************************
+*
+*  @file       strutil/builder.h
+*  @brief      string_builder and to_string
+*
+******************************************************************************
+*/
+
+#pragma once
+
+#include "core.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace strutil {
+namespace detail {
+/**
+ * @brief Fills dst with count copies of str by copying the already written part onto the rest,
+ *        doubling the copied block each time: O(log count) memcpy calls.
+ * @param dst - destination with room for str.size() * count bytes.
+ * @param str - the string to repeat.
+ * @param count - number of copies.
+ */
+inline void fill_repeated(char* dst, std::string_view str, std::size_t count) {
+    const std::size_t total = str.size() * count;
+    if (total == 0) {
+        return;
+    }
+    std::memcpy(dst, str.data(), str.size());
+    for (std::size_t filled = str.size(); filled < total;) {
+        const std::size_t chunk = std::min(filled, total - filled);
+        std::memcpy(dst + filled, dst, chunk);
+        filled += chunk;
+    }
+}
+
+/**
+ * @brief True for the character types that std::ostream prints as characters rather than numbers.
+ */
+template<typename T>
+inline constexpr bool is_narrow_char_v = std::is_same_v<T, char> || std::is_same_v<T, signed char> || std::is_same_v<T, unsigned char>;
+
+/**
+ * @brief True for the arithmetic types string_builder formats with std::to_chars.
+ */
+template<typename T>
+inline constexpr bool is_to_chars_number_v = std::is_floating_point_v<T>
+                                      || (std::is_integral_v<T> && !std::is_same_v<T, bool> && !is_narrow_char_v<T>
+                                          && !std::is_same_v<T, wchar_t> && !std::is_same_v<T, char16_t>
+                                          && !std::is_same_v<T, char32_t>);
+} // namespace detail
+
+/**
+ * @brief Append-only string buffer for building strings without std::ostringstream.
+ *        Short results live in an inline buffer, longer ones in a heap buffer that grows geometrically.
+ *        Numbers are formatted with std::to_chars the same way operator<< formats them on a default stream
+ *        (floating point with the "%g" style and precision 6), without locale lookups.
+ */
+class string_builder {
+public:
+    string_builder() noexcept : data_(inline_) {}
+
+    /**
+     * @param capacity_hint - expected size of the result, reserved up front.
+     */
+    explicit string_builder(std::size_t capacity_hint) : string_builder() {
+        reserve(capacity_hint);
+    }
+
+    string_builder(const string_builder&) = delete;
+    string_builder& operator=(const string_builder&) = delete;
+
+    string_builder(string_builder&& other) noexcept : string_builder() {
+        move_from(other);
+    }
+
+    string_builder& operator=(string_builder&& other) noexcept {
+        if (this != &other) {
+            move_from(other);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Makes room for at least capacity characters in total.
+     */
+    void reserve(std::size_t capacity) {
+        if (capacity > capacity_) {
+            reallocate(capacity);
+        }
+    }
+
+    /**
+     * @brief Appends a string.
+     */
+    string_builder& append(std::string_view str) {
+        if (!str.empty()) {
+            std::memcpy(extend(str.size()), str.data(), str.size());
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Appends a character.
+     */
+    string_builder& append(char c) {
+        *extend(1) = c;
+        return *this;
+    }
+
+    /**
+     * @brief Appends count copies of a character.
+     */
+    string_builder& append(char c, std::size_t count) {
+        std::memset(extend(count), c, count);
+        return *this;
+    }
+
+    /**
+     * @brief Appends "1" or "0", as operator<< does for bool.
+     */
+    string_builder& append(bool value) {
+        return append(value ? '1' : '0');
+    }
+
+    /**
+     * @brief Appends an integer or a floating point number formatted with std::to_chars.
+     */
+    template<typename T, std::enable_if_t<detail::is_to_chars_number_v<T>, int> = 0>
+    string_builder& append(T value) {
+        char buffer[64];
+        std::to_chars_result result;
+        if constexpr (std::is_floating_point_v<T>) {
+            result = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::general, 6);
+        } else {
+            result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        }
+        return append(std::string_view(buffer, static_cast<std::size_t>(result.ptr - buffer)));
+    }
+
+    /**
+     * @brief Appends count copies of str, copying by doubling blocks.
+     */
+    string_builder& append_repeated(std::string_view str, std::size_t count) {
+        detail::fill_repeated(extend(str.size() * count), str, count);
+        return *this;
+    }
+
+    /**
+     * @brief Appends a value the way std::ostream would print it. Strings, characters and numbers are
+     *        appended directly; other types fall back to their operator<< through a reused stream.
+     */
+    template<typename T>
+    string_builder& operator<<(const T& value) {
+        if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+            return append(std::string_view(value));
+        } else if constexpr (std::is_same_v<T, bool>) {
+            return append(value);
+        } else if constexpr (detail::is_narrow_char_v<T>) {
+            return append(static_cast<char>(value));
+        } else if constexpr (detail::is_to_chars_number_v<T>) {
+            return append(value);
+        } else {
+            if (!stream_) {
+                stream_ = std::make_unique<std::ostringstream>();
+            }
+            stream_->str(std::string());
+            *stream_ << value;
+            return append(stream_->str());
+        }
+    }
+
+    /**
+     * @brief Returns a view of the contents, valid until the next modification.
+     */
+    std::string_view view() const {
+        return std::string_view(data_, size_);
+    }
+
+    /**
+     * @brief Returns the contents as std::string.
+     */
+    std::string str() const {
+        return std::string(data_, size_);
+    }
+
+    std::size_t size() const {
+        return size_;
+    }
+
+    std::size_t capacity() const {
+        return capacity_;
+    }
+
+    bool empty() const {
+        return size_ == 0;
+    }
+
+    /**
+     * @brief Removes the contents, keeping the capacity.
+     */
+    void clear() {
+        size_ = 0;
+    }
+
+private:
+    static constexpr std::size_t INLINE_CAPACITY = 128;
+
+    char* extend(std::size_t count) {
+        if (count > capacity_ - size_) {
+            reallocate(std::max(size_ + count, capacity_ * 2));
+        }
+        char* end = data_ + size_;
+        size_ += count;
+        return end;
+    }
+
+    void reallocate(std::size_t capacity) {
+        std::unique_ptr<char[]> buffer(new char[capacity]);
+        if (size_ != 0) {
+            std::memcpy(buffer.get(), data_, size_);
+        }
+        heap_ = std::move(buffer);
+        data_ = heap_.get();
+        capacity_ = capacity;
+    }
+
+    void move_from(string_builder& other) {
+        if (other.heap_) {
+            heap_ = std::move(other.heap_);
+            data_ = heap_.get();
+            capacity_ = other.capacity_;
+        } else {
+            heap_.reset();
+            data_ = inline_;
+            capacity_ = INLINE_CAPACITY;
+            std::memcpy(inline_, other.inline_, other.size_);
+        }
+        size_ = other.size_;
+        stream_ = std::move(other.stream_);
+
+        other.data_ = other.inline_;
+        other.capacity_ = INLINE_CAPACITY;
+        other.size_ = 0;
+    }
+
+    char inline_[INLINE_CAPACITY];
+    char* data_;
+    std::size_t size_ = 0;
+    std::size_t capacity_ = INLINE_CAPACITY;
+    std::unique_ptr<char[]> heap_;
+    std::unique_ptr<std::ostringstream> stream_;
+};
+
+/**
+ * @brief Converts any datatype into std::string.
+ *        Datatype must support << operator. Strings, characters and numbers are formatted without a stream.
+ * @tparam T
+ * @param value - will be converted into std::string.
+ * @return Converted value as std::string.
+ */
+template<typename T>
+std::string to_string(T value) {
+    string_builder result;
+    result << value;
+    return result.str();
+}
+
+} // namespace strutil
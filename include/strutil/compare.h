@@ -0,0 +1,228 @@
+/**
+******************************************************************************
+*
+*  @file       strutil/compare.h
+*  @brief      Substring search, prefix/suffix checks and case-insensitive comparison
+*
+******************************************************************************
+*/
+
+#pragma once
+
+#include "core.h"
+#include "dispatch.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+namespace strutil {
+/**
+ * @brief Converts only the first character of a string to uppercase letter, all other characters stay unchanged.
+ * @param str - input string to be modified.
+ * @return A string with the first letter capitalized. All other characters stay unchanged. It doesn't modify the input string.
+ */
+inline bool contains(std::string_view str, std::string_view substring) {
+    return str.find(substring) != std::string::npos;
+}
+
+/**
+ * @brief Checks if input std::string_view str contains specified character.
+ * @param str - std::string to be checked.
+ * @param character - searched character.
+ * @return True if character was found in str, false otherwise.
+ */
+inline bool contains(std::string_view str, const char character) {
+    return str.find(character) != std::string::npos;
+}
+
+/**
+ * @brief Compares two strings ignoring their case (lower/upper).
+ * @param str1 - string to compare
+ * @param str2 - string to compare
+ * @return True if str1 and str2 are equal, false otherwise.
+ */
+inline bool compare_ignore_case(std::string_view str1, std::string_view str2) {
+    return str1.size() == str2.size()
+           && std::equal(str1.begin(),
+                         str1.end(),
+                         str2.begin(),
+                         [](char c1, char c2) { return std::tolower(c1) == std::tolower(c2); });
+}
+
+namespace detail {
+/**
+ * @brief Both cases of the first and last byte of a substring searched ignoring ASCII case.
+ */
+struct ignore_case_needle {
+    char first_lower;
+    char first_upper;
+    char last_lower;
+    char last_upper;
+};
+
+inline ignore_case_needle make_ignore_case_needle(std::string_view substring) {
+    const auto swap_case = [](unsigned char c) {
+        return static_cast<char>((c >= 'a' && c <= 'z') ? c ^ 0x20 : c);
+    };
+    const char first_lower = static_cast<char>(ascii_to_lower(static_cast<unsigned char>(substring.front())));
+    const char last_lower = static_cast<char>(ascii_to_lower(static_cast<unsigned char>(substring.back())));
+    return {first_lower, swap_case(static_cast<unsigned char>(first_lower)), last_lower, swap_case(static_cast<unsigned char>(last_lower))};
+}
+
+/**
+ * @brief Finds substring in str at or after pos ignoring ASCII case, checking one candidate position
+ *        at a time. Requires a non-empty substring that fits into str after pos.
+ */
+inline std::size_t find_ignore_case_scalar(std::string_view str, std::string_view substring, std::size_t pos) {
+    const ignore_case_needle needle = make_ignore_case_needle(substring);
+    const std::size_t last_offset = substring.size() - 1;
+    for (std::size_t i = pos; i <= str.size() - substring.size(); ++i) {
+        if ((str[i] == needle.first_lower || str[i] == needle.first_upper)
+            && (str[i + last_offset] == needle.last_lower || str[i + last_offset] == needle.last_upper)
+            && ascii_equal_ignore_case(str.data() + i + 1, substring.data() + 1, substring.size() - 1)) {
+            return i;
+        }
+    }
+    return std::string_view::npos;
+}
+
+#if defined(__SSE2__)
+/**
+ * @brief SSE2 version of find_ignore_case_scalar: candidates are located 16 positions at a time by
+ *        matching both cases of the first and last byte of substring, then verified.
+ */
+inline std::size_t find_ignore_case_sse2(std::string_view str, std::string_view substring, std::size_t pos) {
+    const ignore_case_needle needle = make_ignore_case_needle(substring);
+    const std::size_t last_offset = substring.size() - 1;
+    const std::size_t last_start = str.size() - substring.size();
+    const __m128i first_lowers = _mm_set1_epi8(needle.first_lower);
+    const __m128i first_uppers = _mm_set1_epi8(needle.first_upper);
+    const __m128i last_lowers = _mm_set1_epi8(needle.last_lower);
+    const __m128i last_uppers = _mm_set1_epi8(needle.last_upper);
+    std::size_t i = pos;
+    for (; i + 16 <= last_start + 1; i += 16) {
+        const __m128i firsts = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str.data() + i));
+        const __m128i lasts = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str.data() + i + last_offset));
+        const __m128i first_matches = _mm_or_si128(_mm_cmpeq_epi8(firsts, first_lowers), _mm_cmpeq_epi8(firsts, first_uppers));
+        const __m128i last_matches = _mm_or_si128(_mm_cmpeq_epi8(lasts, last_lowers), _mm_cmpeq_epi8(lasts, last_uppers));
+        for (auto mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_and_si128(first_matches, last_matches))); mask != 0;
+             mask &= mask - 1) {
+            const std::size_t candidate = i + count_trailing_zeros(mask);
+            if (ascii_equal_ignore_case(str.data() + candidate + 1, substring.data() + 1, substring.size() - 1)) {
+                return candidate;
+            }
+        }
+    }
+    return find_ignore_case_scalar(str, substring, i);
+}
+#endif
+
+inline constexpr kernel_family<std::size_t (*)(std::string_view, std::string_view, std::size_t)> FIND_IGNORE_CASE_KERNELS{
+    "find_ignore_case", {&find_ignore_case_scalar, STRUTIL_SSE2_KERNEL(&find_ignore_case_sse2), nullptr, nullptr}};
+inline const bool FIND_IGNORE_CASE_KERNELS_REGISTERED = register_kernel(FIND_IGNORE_CASE_KERNELS);
+} // namespace detail
+
+/**
+ * @brief Finds the first occurrence of substring in str ignoring ASCII case, without allocating.
+ *        Candidates are located in SIMD blocks by matching both cases of the first and last byte
+ *        of substring, then verified.
+ * @param str - std::string_view to search in.
+ * @param substring - searched substring.
+ * @param pos - position at which to start the search.
+ * @return Position of the first occurrence, or std::string_view::npos if there is none.
+ */
+inline std::size_t find_ignore_case(std::string_view str, std::string_view substring, std::size_t pos = 0) {
+    if (pos > str.size() || substring.size() > str.size() - pos) {
+        return std::string_view::npos;
+    }
+    if (substring.empty()) {
+        return pos;
+    }
+    return detail::FIND_IGNORE_CASE_KERNELS.get()(str, substring, pos);
+}
+
+/**
+ * @brief Checks if str contains substring ignoring ASCII case, without allocating lowercase copies.
+ * @param str - std::string_view to be checked.
+ * @param substring - searched substring.
+ * @return True if substring was found in str ignoring case, false otherwise.
+ */
+inline bool contains_ignore_case(std::string_view str, std::string_view substring) {
+    return find_ignore_case(str, substring) != std::string_view::npos;
+}
+
+/**
+ * @brief Checks if str starts with prefix ignoring ASCII case.
+ * @param str - input std::string_view that will be checked.
+ * @param prefix - searched prefix in str.
+ * @return True if prefix was found, false otherwise.
+ */
+inline bool starts_with_ignore_case(std::string_view str, std::string_view prefix) {
+    return str.size() >= prefix.size() && detail::ascii_equal_ignore_case(str.data(), prefix.data(), prefix.size());
+}
+
+/**
+ * @brief Checks if str ends with suffix ignoring ASCII case.
+ * @param str - input std::string_view that will be checked.
+ * @param suffix - searched suffix in str.
+ * @return True if suffix was found, false otherwise.
+ */
+inline bool ends_with_ignore_case(std::string_view str, std::string_view suffix) {
+    return str.size() >= suffix.size()
+           && detail::ascii_equal_ignore_case(str.data() + str.size() - suffix.size(), suffix.data(), suffix.size());
+}
+
+/**
+ * @brief Checks if std::string_view str ends with specified suffix.
+ * @param str - input std::string_view that will be checked.
+ * @param suffix - searched suffix in str.
+ * @return True if suffix was found, false otherwise.
+ */
+inline bool ends_with(std::string_view str, std::string_view suffix) {
+    const auto suffix_start = str.size() - suffix.size();
+    const auto result = str.find(suffix, suffix_start);
+    return (result == suffix_start) && (result != std::string::npos);
+}
+
+/**
+ * @brief Checks if std::string_view str ends with specified character.
+ * @param str - input std::string_view that will be checked.
+ * @param suffix - searched character in str.
+ * @return True if ends with character, false otherwise.
+ */
+inline bool ends_with(std::string_view str, const char suffix) {
+    return !str.empty() && (str.back() == suffix);
+}
+
+/**
+ * @brief Checks if std::string_view str starts with specified prefix.
+ * @param str - input std::string_view that will be checked.
+ * @param prefix - searched prefix in str.
+ * @return True if prefix was found, false otherwise.
+ */
+inline bool starts_with(std::string_view str, std::string_view prefix) {
+    return str.rfind(prefix, 0) == 0;
+}
+
+/**
+ * @brief Checks if std::string_view str starts with specified character.
+ * @param str - input std::string_view that will be checked.
+ * @param prefix - searched character in str.
+ * @return True if starts with character, false otherwise.
+ */
+inline bool starts_with(std::string_view str, const char prefix) {
+    return !str.empty() && (str.front() == prefix);
+}
+
+/**
+ * @returns true if string does not contain characters other than latin letters, both uppercase and lowercase, and digits
+ */
+inline bool is_alphanumeric(std::string_view s) {
+    return std::all_of(s.begin(), s.end(), [](char c) { return bool(std::isalnum(c)); });
+}
+
+} // namespace strutil
@@ -0,0 +1,99 @@
+/**
+******************************************************************************
+*
+*  @file       strutil/core.h
+*  @brief      Common internal helpers shared by the feature headers
+*
+******************************************************************************
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// GCC and Clang can compile AVX2 and AVX-512 functions with a target attribute and pick them at runtime,
+// see strutil/dispatch.h
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define STRUTIL_X86_RUNTIME_DISPATCH 1
+#include <immintrin.h>
+#endif
+
+//! The strutil namespace
+namespace strutil {
+namespace detail {
+/**
+ * @brief Returns the number of trailing zero bits of a non-zero mask.
+ */
+inline unsigned count_trailing_zeros(std::uint64_t mask) {
+#if defined(__GNUC__)
+    return static_cast<unsigned>(__builtin_ctzll(mask));
+#else
+    unsigned count = 0;
+    while ((mask & 1u) == 0) {
+        mask >>= 1;
+        ++count;
+    }
+    return count;
+#endif
+}
+
+/**
+ * @brief Returns the number of set bits of mask.
+ */
+inline unsigned popcount(unsigned mask) {
+#if defined(__GNUC__)
+    return static_cast<unsigned>(__builtin_popcount(mask));
+#else
+    unsigned count = 0;
+    for (; mask != 0; mask &= mask - 1) {
+        ++count;
+    }
+    return count;
+#endif
+}
+
+/**
+ * @brief Lowercases an ASCII letter independently of the current locale.
+ * @param c - character to convert.
+ * @return c with 'A'-'Z' mapped to 'a'-'z'.
+ */
+constexpr unsigned char ascii_to_lower(unsigned char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<unsigned char>(c | 0x20) : c;
+}
+
+/**
+ * @brief Compares two strings of equal size ignoring ASCII case.
+ */
+inline bool ascii_equal_ignore_case(const char* str1, const char* str2, std::size_t size) {
+    for (std::size_t i = 0; i < size; ++i) {
+        if (ascii_to_lower(static_cast<unsigned char>(str1[i])) != ascii_to_lower(static_cast<unsigned char>(str2[i]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Returns the value of a hexadecimal digit, or -1 if c is not one.
+ */
+inline int hex_digit_value(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+} // namespace detail
+
+} // namespace strutil
@@ -0,0 +1,250 @@
+/**
+******************************************************************************
+*
+*  @file       strutil/dispatch.h
+*  @brief      Runtime selection of the SIMD kernels: CPU detection, override and introspection
+*
+******************************************************************************
+*/
+
+#pragma once
+
+#include "core.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+// Entries of kernel_family tables: a kernel compiled only for some targets is nullptr elsewhere
+#if defined(__SSE2__)
+#define STRUTIL_SSE2_KERNEL(fn) fn
+#else
+#define STRUTIL_SSE2_KERNEL(fn) nullptr
+#endif
+#if defined(STRUTIL_X86_RUNTIME_DISPATCH)
+#define STRUTIL_AVX2_KERNEL(fn) fn
+#define STRUTIL_AVX512_KERNEL(fn) fn
+#else
+#define STRUTIL_AVX2_KERNEL(fn) nullptr
+#define STRUTIL_AVX512_KERNEL(fn) nullptr
+#endif
+
+namespace strutil {
+/**
+ * @brief Instruction set levels of the vectorized kernels, each one implying the previous ones.
+ */
+enum class isa_level : unsigned char { scalar, sse2, avx2, avx512 };
+
+/**
+ * @brief The implementation a kernel family currently runs, as reported by strutil::dispatch_report.
+ */
+struct kernel_dispatch {
+    std::string_view name;
+    isa_level level;
+};
+
+namespace detail {
+inline constexpr std::size_t ISA_LEVEL_COUNT = 4;
+inline constexpr std::string_view ISA_LEVEL_NAMES[ISA_LEVEL_COUNT] = {"scalar", "sse2", "avx2", "avx512"};
+
+/**
+ * @brief Returns the highest level the running CPU and operating system support. On x86 with GCC or Clang
+ *        this reads the CPUID results that __builtin_cpu_supports caches at startup, including the
+ *        XGETBV check that the OS saves the AVX and AVX-512 registers.
+ */
+inline isa_level detect_isa() {
+#if defined(STRUTIL_X86_RUNTIME_DISPATCH)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+        return isa_level::avx512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return isa_level::avx2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return isa_level::sse2;
+    }
+#elif defined(__SSE2__)
+    return isa_level::sse2;
+#endif
+    return isa_level::scalar;
+}
+
+/**
+ * @brief Parses "scalar", "sse2", "avx2" or "avx512" into level.
+ * @return False if name is none of them.
+ */
+inline bool parse_isa_level(std::string_view name, isa_level& level) {
+    for (std::size_t i = 0; i < ISA_LEVEL_COUNT; ++i) {
+        if (name == ISA_LEVEL_NAMES[i]) {
+            level = static_cast<isa_level>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief The detected level and the level kernels currently use. The STRUTIL_ISA environment variable,
+ *        if set to a level name, caps the initial level; strutil::set_isa changes it later.
+ */
+struct isa_state {
+    isa_level detected;
+    std::atomic<isa_level> active;
+
+    isa_state() : detected(detect_isa()), active(detected) {
+        isa_level requested = detected;
+        const char* env = std::getenv("STRUTIL_ISA");
+        if (env != nullptr && parse_isa_level(env, requested) && requested < detected) {
+            active.store(requested);
+        }
+    }
+};
+
+inline isa_state& isa() {
+    static isa_state state;
+    return state;
+}
+
+/**
+ * @brief Name and available levels of a kernel family, kept for strutil::dispatch_report.
+ */
+struct kernel_registration {
+    std::string_view name;
+    bool available[ISA_LEVEL_COUNT];
+};
+
+inline std::mutex& kernel_registry_mutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+inline std::vector<kernel_registration>& kernel_registry() {
+    static std::vector<kernel_registration> registry;
+    return registry;
+}
+
+/**
+ * @brief Returns the highest level not above the active one for which available is set.
+ */
+inline isa_level select_level(const bool* available) {
+    auto level = static_cast<std::size_t>(isa().active.load(std::memory_order_relaxed));
+    while (level > 0 && !available[level]) {
+        --level;
+    }
+    return static_cast<isa_level>(level);
+}
+
+/**
+ * @brief One implementation per instruction set level of a kernel, nullptr where there is none.
+ *        The scalar entry is always set. Families are constant-initialized, so they can be called
+ *        at any time, also during static initialization.
+ * @tparam Fn - function pointer type shared by the implementations.
+ */
+template<typename Fn>
+struct kernel_family {
+    std::string_view name;
+    Fn impls[ISA_LEVEL_COUNT];
+
+    /**
+     * @brief Returns the implementation for the active level, falling back to the next lower one.
+     */
+    Fn get() const {
+        auto level = static_cast<std::size_t>(isa().active.load(std::memory_order_relaxed));
+        while (level > 0 && impls[level] == nullptr) {
+            --level;
+        }
+        return impls[level];
+    }
+};
+
+/**
+ * @brief Adds a kernel family to the registry read by strutil::dispatch_report.
+ * @return True, for initializing an inline variable next to the family.
+ */
+template<typename Fn>
+bool register_kernel(const kernel_family<Fn>& family) {
+    kernel_registration registration{family.name, {}};
+    for (std::size_t i = 0; i < ISA_LEVEL_COUNT; ++i) {
+        registration.available[i] = family.impls[i] != nullptr;
+    }
+    const std::lock_guard<std::mutex> lock(kernel_registry_mutex());
+    kernel_registry().push_back(registration);
+    return true;
+}
+} // namespace detail
+
+/**
+ * @brief Returns the name of an instruction set level: "scalar", "sse2", "avx2" or "avx512".
+ */
+inline std::string_view isa_name(isa_level level) {
+    return detail::ISA_LEVEL_NAMES[static_cast<std::size_t>(level)];
+}
+
+/**
+ * @brief Returns the highest instruction set level supported by the running CPU.
+ */
+inline isa_level detected_isa() {
+    return detail::isa().detected;
+}
+
+/**
+ * @brief Returns the highest instruction set level the kernels currently use.
+ */
+inline isa_level active_isa() {
+    return detail::isa().active.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Limits the kernels to level, e.g. isa_level::scalar where vector instructions are not allowed
+ *        or to compare implementations. Levels above strutil::detected_isa are capped to it.
+ *        Calls already running finish with the implementation they started with.
+ * @param level - the highest level to use.
+ * @return The level now active.
+ */
+inline isa_level set_isa(isa_level level) {
+    detail::isa_state& state = detail::isa();
+    const isa_level active = level < state.detected ? level : state.detected;
+    state.active.store(active, std::memory_order_relaxed);
+    return active;
+}
+
+/**
+ * @brief Parses a level name ("scalar", "sse2", "avx2" or "avx512", the values accepted by the
+ *        STRUTIL_ISA environment variable) and limits the kernels to it, see strutil::set_isa.
+ * @param name - the level name.
+ * @return False if name is not a level name; the active level is then unchanged.
+ */
+inline bool set_isa(std::string_view name) {
+    isa_level level = isa_level::scalar;
+    if (!detail::parse_isa_level(name, level)) {
+        return false;
+    }
+    set_isa(level);
+    return true;
+}
+
+/**
+ * @brief Reports which implementation every kernel family of the included headers currently uses:
+ *        the highest level not above strutil::active_isa that the family implements.
+ * @return One entry per kernel family, sorted by name.
+ */
+inline std::vector<kernel_dispatch> dispatch_report() {
+    std::vector<kernel_dispatch> report;
+    {
+        const std::lock_guard<std::mutex> lock(detail::kernel_registry_mutex());
+        for (const detail::kernel_registration& registration : detail::kernel_registry()) {
+            report.push_back({registration.name, detail::select_level(registration.available)});
+        }
+    }
+    std::sort(report.begin(), report.end(), [](const kernel_dispatch& lhs, const kernel_dispatch& rhs) {
+        return lhs.name < rhs.name;
+    });
+    return report;
+}
+
+} // namespace strutil
@@ -0,0 +1,786 @@
+/**
+******************************************************************************
+*
+*  @file       strutil/encode.h
+*  @brief      Byte to text encodings (hexadecimal, binary, base64) and escaping
+*
+******************************************************************************
+*/
+
+#pragma once
+
+#include "core.h"
+#include "dispatch.h"
+#include "stats.h"
+
+#include <algorithm>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace strutil {
+namespace detail {
+/**
+ * @brief Writes the two hexadecimal digits of every byte of data to dst.
+ * @param dst - destination with room for size * 2 characters.
+ * @param data - bytes to convert.
+ * @param size - number of bytes in data.
+ * @param uppercase - use uppercase hexadecimal digits.
+ */
+inline void write_hex(char* dst, const uint8_t* data, std::size_t size, bool uppercase) {
+    const char* digits = uppercase ? "0123456789ABCDEF" : "0123456789abcdef";
+    for (std::size_t i = 0; i < size; ++i) {
+        dst[i * 2] = digits[data[i] >> 4];
+        dst[i * 2 + 1] = digits[data[i] & 0x0F];
+    }
+}
+
+/**
+ * @brief Appends ch to out, replacing non-printable characters with escape sequences
+ *        ("\\n", "\\t", "\\0", ..., or "\\xHH" for anything else).
+ * @param out - string receiving the character.
+ * @param ch - the character to append.
+ */
+inline void append_escaped(std::string& out, unsigned char ch) {
+    static constexpr char HEX_DIGITS[] = "0123456789ABCDEF";
+
+    switch (ch) {
+        case '\\':
+            out.append("\\\\");
+            break;
+        case '\n':
+            out.append("\\n");
+            break;
+        case '\r':
+            out.append("\\r");
+            break;
+        case '\t':
+            out.append("\\t");
+            break;
+        case '\0':
+            out.append("\\0");
+            break;
+        case '\b':
+            out.append("\\b");
+            break;
+        case '\f':
+            out.append("\\f");
+            break;
+        case '\v':
+            out.append("\\v");
+            break;
+        default:
+            if (ch >= 0x20 && ch < 0x7F) {
+                out.push_back(static_cast<char>(ch));
+            } else {
+                char buffer[4] = {'\\', 'x', HEX_DIGITS[ch >> 4], HEX_DIGITS[ch & 0x0F]};
+                out.append(buffer, 4);
+            }
+            break;
+    }
+}
+
+/**
+ * @brief Returns the position of the first byte at or after pos that strutil::escape_c rewrites:
+ *        a backslash or anything outside printable ASCII (0x20..0x7E), or size if there is none.
+ */
+inline std::size_t find_c_escape_scalar(const char* data, std::size_t size, std::size_t pos) {
+    for (; pos < size; ++pos) {
+        const auto ch = static_cast<unsigned char>(data[pos]);
+        if (ch < 0x20 || ch >= 0x7F || ch == '\\') {
+            return pos;
+        }
+    }
+    return size;
+}
+
+/**
+ * @brief Returns the position of the first byte at or after pos that strutil::escape_json rewrites:
+ *        a control character, '"' or a backslash, or size if there is none.
+ */
+inline std::size_t find_json_escape_scalar(const char* data, std::size_t size, std::size_t pos) {
+    for (; pos < size; ++pos) {
+        const auto ch = static_cast<unsigned char>(data[pos]);
+        if (ch < 0x20 || ch == '"' || ch == '\\') {
+            return pos;
+        }
+    }
+    return size;
+}
+
+#if defined(__SSE2__)
+/**
+ * @brief Marks the bytes strutil::escape_c rewrites. Bytes >= 0x80 compare as negative,
+ *        so one signed compare catches them with the control characters.
+ */
+inline __m128i c_escape_bytes_sse2(__m128i bytes) {
+    return _mm_or_si128(_mm_cmplt_epi8(bytes, _mm_set1_epi8(' ')),
+                        _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(0x7F)), _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\\'))));
+}
+
+/**
+ * @brief Marks the bytes strutil::escape_json rewrites; min(byte, 0x1F) == byte holds exactly
+ *        for the control characters 0x00..0x1F.
+ */
+inline __m128i json_escape_bytes_sse2(__m128i bytes) {
+    const __m128i control = _mm_cmpeq_epi8(_mm_min_epu8(bytes, _mm_set1_epi8(0x1F)), bytes);
+    return _mm_or_si128(control, _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('"')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\\'))));
+}
+
+/**
+ * @brief Finds the first byte marked by escape_bytes, skipping clean text 64 bytes per test and
+ *        looking up the exact position only in a dirty block.
+ */
+template<__m128i (*EscapeBytes)(__m128i), std::size_t (*FindScalar)(const char*, std::size_t, std::size_t)>
+std::size_t find_escape_sse2(const char* data, std::size_t size, std::size_t pos) {
+    const auto load = [data](std::size_t offset) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset)); };
+    for (; pos + 64 <= size; pos += 64) {
+        const __m128i any = _mm_or_si128(_mm_or_si128(EscapeBytes(load(pos)), EscapeBytes(load(pos + 16))),
+                                         _mm_or_si128(EscapeBytes(load(pos + 32)), EscapeBytes(load(pos + 48))));
+        if (_mm_movemask_epi8(any) != 0) {
+            break;
+        }
+    }
+    for (; pos + 16 <= size; pos += 16) {
+        const auto mask = static_cast<unsigned>(_mm_movemask_epi8(EscapeBytes(load(pos))));
+        if (mask != 0) {
+            return pos + count_trailing_zeros(mask);
+        }
+    }
+    return FindScalar(data, size, pos);
+}
+#endif
+
+#if defined(STRUTIL_X86_RUNTIME_DISPATCH)
+__attribute__((target("avx2"))) inline __m256i c_escape_bytes_avx2(__m256i bytes) {
+    return _mm256_or_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(' '), bytes),
+                           _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(0x7F)), _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\\'))));
+}
+
+__attribute__((target("avx2"))) inline __m256i json_escape_bytes_avx2(__m256i bytes) {
+    const __m256i control = _mm256_cmpeq_epi8(_mm256_min_epu8(bytes, _mm256_set1_epi8(0x1F)), bytes);
+    return _mm256_or_si256(control, _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('"')), _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\\'))));
+}
+
+/**
+ * @brief AVX2 variant of find_escape_sse2, 32 bytes per compare.
+ */
+template<__m256i (*EscapeBytes)(__m256i), std::size_t (*FindScalar)(const char*, std::size_t, std::size_t)>
+__attribute__((target("avx2"))) std::size_t find_escape_avx2(const char* data, std::size_t size, std::size_t pos) {
+    for (; pos + 64 <= size; pos += 64) {
+        const __m256i any = _mm256_or_si256(EscapeBytes(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos))),
+                                            EscapeBytes(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos + 32))));
+        if (!_mm256_testz_si256(any, any)) {
+            break;
+        }
+    }
+    for (; pos + 32 <= size; pos += 32) {
+        const auto mask = static_cast<unsigned>(_mm256_movemask_epi8(EscapeBytes(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos)))));
+        if (mask != 0) {
+            return pos + count_trailing_zeros(mask);
+        }
+    }
+    return FindScalar(data, size, pos);
+}
+
+__attribute__((target("avx512f,avx512bw"))) inline __mmask64 c_escape_bytes_avx512(__m512i bytes) {
+    return _mm512_cmplt_epu8_mask(bytes, _mm512_set1_epi8(' ')) | _mm512_cmpge_epu8_mask(bytes, _mm512_set1_epi8(0x7F))
+           | _mm512_cmpeq_epi8_mask(bytes, _mm512_set1_epi8('\\'));
+}
+
+__attribute__((target("avx512f,avx512bw"))) inline __mmask64 json_escape_bytes_avx512(__m512i bytes) {
+    return _mm512_cmplt_epu8_mask(bytes, _mm512_set1_epi8(0x20)) | _mm512_cmpeq_epi8_mask(bytes, _mm512_set1_epi8('"'))
+           | _mm512_cmpeq_epi8_mask(bytes, _mm512_set1_epi8('\\'));
+}
+
+/**
+ * @brief AVX-512BW variant of find_escape_sse2: 64 bytes per compare, and a masked load for the tail
+ *        instead of a scalar loop.
+ */
+template<__mmask64 (*EscapeBytes)(__m512i)>
+__attribute__((target("avx512f,avx512bw"))) std::size_t find_escape_avx512(const char* data, std::size_t size, std::size_t pos) {
+    for (; pos < size; pos += 64) {
+        const std::size_t count = std::min<std::size_t>(64, size - pos);
+        const __mmask64 valid = count == 64 ? ~__mmask64{0} : (__mmask64{1} << count) - 1;
+        const __mmask64 mask = EscapeBytes(_mm512_maskz_loadu_epi8(valid, data + pos)) & valid;
+        if (mask != 0) {
+            return pos + count_trailing_zeros(mask);
+        }
+    }
+    return size;
+}
+#endif
+
+using find_escape_fn = std::size_t (*)(const char*, std::size_t, std::size_t);
+
+inline constexpr kernel_family<find_escape_fn> C_ESCAPE_KERNELS{
+    "escape_c",
+    {&find_c_escape_scalar,
+     STRUTIL_SSE2_KERNEL((&find_escape_sse2<&c_escape_bytes_sse2, &find_c_escape_scalar>)),
+     STRUTIL_AVX2_KERNEL((&find_escape_avx2<&c_escape_bytes_avx2, &find_c_escape_scalar>)),
+     STRUTIL_AVX512_KERNEL(&find_escape_avx512<&c_escape_bytes_avx512>)}};
+inline const bool C_ESCAPE_KERNELS_REGISTERED = register_kernel(C_ESCAPE_KERNELS);
+
+inline constexpr kernel_family<find_escape_fn> JSON_ESCAPE_KERNELS{
+    "escape_json",
+    {&find_json_escape_scalar,
+     STRUTIL_SSE2_KERNEL((&find_escape_sse2<&json_escape_bytes_sse2, &find_json_escape_scalar>)),
+     STRUTIL_AVX2_KERNEL((&find_escape_avx2<&json_escape_bytes_avx2, &find_json_escape_scalar>)),
+     STRUTIL_AVX512_KERNEL(&find_escape_avx512<&json_escape_bytes_avx512>)}};
+inline const bool JSON_ESCAPE_KERNELS_REGISTERED = register_kernel(JSON_ESCAPE_KERNELS);
+} // namespace detail
+
+/**
+ * @brief converts a byte array to its hexadecimal string representation.
+ * @param size - number of chars in string
+ */
+inline std::string to_hex_string(const uint8_t* data, size_t size, bool uppercase = true) {
+    std::string result(size * 2, '0');
+    detail::write_hex(result.data(), data, size, uppercase);
+    return result;
+}
+
+/**
+ * @brief converts a byte array to its hexadecimal string representation allocated from resource.
+ * @param data - bytes to convert.
+ * @param size - number of bytes in data.
+ * @param uppercase - use uppercase hexadecimal digits.
+ * @param resource - memory resource used for the result.
+ */
+inline std::pmr::string to_hex_string(const uint8_t* data, size_t size, bool uppercase, std::pmr::memory_resource* resource) {
+    std::pmr::string result(size * 2, '0', resource);
+    detail::write_hex(result.data(), data, size, uppercase);
+    return result;
+}
+
+/**
+ * @brief converts a byte array to its binary string representation.
+ * @param size - number of chars in string
+ */
+inline std::string to_binary_string(const uint8_t* data, size_t size) {
+    std::string result(size * 8, '0');
+    for (size_t i = 0; i < size; ++i) {
+        for (int j = 7; j >= 0; --j) {
+            result[i * 8 + (7 - j)] = (data[i] & (1 << j)) ? '1' : '0';
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Base64 alphabets of RFC 4648: standard ("+/", section 4) and URL and filename safe ("-_", section 5).
+ */
+enum class base64_alphabet { standard, url };
+
+namespace detail {
+/**
+ * @brief Encoding table of a base64 alphabet and its inverse; 0xFF marks bytes outside the alphabet.
+ */
+struct base64_table {
+    char encode[64];
+    unsigned char decode[256];
+};
+
+constexpr base64_table make_base64_table(char char62, char char63) {
+    base64_table table{};
+    for (int i = 0; i < 26; ++i) {
+        table.encode[i] = static_cast<char>('A' + i);
+        table.encode[26 + i] = static_cast<char>('a' + i);
+    }
+    for (int i = 0; i < 10; ++i) {
+        table.encode[52 + i] = static_cast<char>('0' + i);
+    }
+    table.encode[62] = char62;
+    table.encode[63] = char63;
+    for (unsigned char& value : table.decode) {
+        value = 0xFF;
+    }
+    for (int i = 0; i < 64; ++i) {
+        table.decode[static_cast<unsigned char>(table.encode[i])] = static_cast<unsigned char>(i);
+    }
+    return table;
+}
+
+inline constexpr base64_table BASE64_STANDARD = make_base64_table('+', '/');
+inline constexpr base64_table BASE64_URL = make_base64_table('-', '_');
+
+/**
+ * @brief Encodes all complete 3-byte groups of data, one table lookup per character.
+ * @return Number of input bytes consumed, a multiple of 3.
+ */
+inline std::size_t encode_base64_scalar(const uint8_t* data, std::size_t size, char* out, bool url) {
+    const base64_table& table = url ? BASE64_URL : BASE64_STANDARD;
+    std::size_t i = 0;
+    for (; size - i >= 3; i += 3) {
+        const std::uint32_t triple = (std::uint32_t{data[i]} << 16) | (std::uint32_t{data[i + 1]} << 8) | data[i + 2];
+        char* dst = out + i / 3 * 4;
+        dst[0] = table.encode[triple >> 18];
+        dst[1] = table.encode[(triple >> 12) & 0x3F];
+        dst[2] = table.encode[(triple >> 6) & 0x3F];
+        dst[3] = table.encode[triple & 0x3F];
+    }
+    return i;
+}
+
+/**
+ * @brief Decodes complete 4-character groups of str, stopping before the first group that holds
+ *        a byte outside the alphabet.
+ * @return Number of characters consumed, a multiple of 4.
+ */
+inline std::size_t decode_base64_scalar(const char* str, std::size_t size, uint8_t* out, bool url) {
+    const base64_table& table = url ? BASE64_URL : BASE64_STANDARD;
+    const auto decode = [&](std::size_t pos) { return std::uint32_t{table.decode[static_cast<unsigned char>(str[pos])]}; };
+    std::size_t i = 0;
+    for (; size - i >= 4; i += 4) {
+        const std::uint32_t a = decode(i);
+        const std::uint32_t b = decode(i + 1);
+        const std::uint32_t c = decode(i + 2);
+        const std::uint32_t d = decode(i + 3);
+        if ((a | b | c | d) & 0x80) {
+            break;
+        }
+        const std::uint32_t triple = (a << 18) | (b << 12) | (c << 6) | d;
+        uint8_t* dst = out + i / 4 * 3;
+        dst[0] = static_cast<uint8_t>(triple >> 16);
+        dst[1] = static_cast<uint8_t>(triple >> 8);
+        dst[2] = static_cast<uint8_t>(triple);
+    }
+    return i;
+}
+
+#if defined(STRUTIL_X86_RUNTIME_DISPATCH)
+/**
+ * @brief Maps 32 six-bit values to base64 characters: one saturating subtract and compare pick a
+ *        per-range offset from a 16-entry table (Muła's method).
+ */
+__attribute__((target("avx2"))) inline __m256i base64_encode_chars_avx2(__m256i indices, bool url) {
+    __m256i reduced = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+    const __m256i less = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+    reduced = _mm256_or_si256(reduced, _mm256_and_si256(less, _mm256_set1_epi8(13)));
+    const char char62 = url ? '-' : '+';
+    const char char63 = url ? '_' : '/';
+    const __m256i shift = _mm256_setr_epi8(
+        'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        static_cast<char>(char62 - 62), static_cast<char>(char63 - 63), 'A', 0, 0,
+        'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        static_cast<char>(char62 - 62), static_cast<char>(char63 - 63), 'A', 0, 0);
+    return _mm256_add_epi8(indices, _mm256_shuffle_epi8(shift, reduced));
+}
+
+/**
+ * @brief Encodes 24 input bytes per iteration into 32 characters, and the remaining complete
+ *        groups with encode_base64_scalar.
+ * @return Number of input bytes consumed, a multiple of 3.
+ */
+__attribute__((target("avx2"))) inline std::size_t encode_base64_avx2(const uint8_t* data, std::size_t size, char* out, bool url) {
+    const __m256i spread = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+                                            1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    std::size_t i = 0;
+    // each 16-byte load uses 12 bytes, so the second one reads 4 bytes past the 24 consumed
+    for (; size - i >= 28; i += 24) {
+        const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 12));
+        const __m256i input = _mm256_shuffle_epi8(_mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1), spread);
+        // split every 3 bytes into four 6-bit values, one per output byte
+        const __m256i ac = _mm256_mulhi_epu16(_mm256_and_si256(input, _mm256_set1_epi32(0x0FC0FC00)), _mm256_set1_epi32(0x04000040));
+        const __m256i bd = _mm256_mullo_epi16(_mm256_and_si256(input, _mm256_set1_epi32(0x003F03F0)), _mm256_set1_epi32(0x01000010));
+        const __m256i chars = base64_encode_chars_avx2(_mm256_or_si256(ac, bd), url);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i / 3 * 4), chars);
+    }
+    return i + encode_base64_scalar(data + i, size - i, out + i / 3 * 4, url);
+}
+
+/**
+ * @brief Decodes 32 characters per iteration into 24 bytes while at least 48 remain, so the 32-byte
+ *        stores stay within the output, then continues with decode_base64_scalar. A block holding
+ *        a byte outside the alphabet is also left to decode_base64_scalar, which stops at its group.
+ * @return Number of characters consumed, a multiple of 4.
+ */
+__attribute__((target("avx2"))) inline std::size_t decode_base64_avx2(const char* str, std::size_t size, uint8_t* out, bool url) {
+    const __m256i nibble_mask = _mm256_set1_epi8(0x0F);
+    // bit sets of the byte classes allowed for every low and high nibble; a zero AND means valid
+    const __m256i valid_low = _mm256_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+                                               0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m256i valid_high = _mm256_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+                                                0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m256i roll = _mm256_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+                                          0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i pack = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                                          2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    std::size_t i = 0;
+    for (; size - i >= 48; i += 32) {
+        __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str + i));
+        if (url) {
+            // the URL alphabet is validated as the standard one after mapping "-_" to "+/"
+            const __m256i standard_only = _mm256_or_si256(_mm256_cmpeq_epi8(input, _mm256_set1_epi8('+')),
+                                                          _mm256_cmpeq_epi8(input, _mm256_set1_epi8('/')));
+            if (!_mm256_testz_si256(standard_only, standard_only)) {
+                break;
+            }
+            input = _mm256_add_epi8(input, _mm256_and_si256(_mm256_cmpeq_epi8(input, _mm256_set1_epi8('-')), _mm256_set1_epi8('+' - '-')));
+            input = _mm256_add_epi8(input, _mm256_and_si256(_mm256_cmpeq_epi8(input, _mm256_set1_epi8('_')), _mm256_set1_epi8('/' - '_')));
+        }
+        const __m256i high_nibbles = _mm256_and_si256(_mm256_srli_epi32(input, 4), nibble_mask);
+        const __m256i low_bits = _mm256_shuffle_epi8(valid_low, _mm256_and_si256(input, nibble_mask));
+        const __m256i high_bits = _mm256_shuffle_epi8(valid_high, high_nibbles);
+        if (!_mm256_testz_si256(low_bits, high_bits)) {
+            break;
+        }
+        const __m256i is_slash = _mm256_cmpeq_epi8(input, _mm256_set1_epi8('/'));
+        const __m256i values = _mm256_add_epi8(input, _mm256_shuffle_epi8(roll, _mm256_add_epi8(is_slash, high_nibbles)));
+
+        // merge four 6-bit values into 3 bytes per 32-bit lane, then drop the empty fourth bytes
+        const __m256i pairs = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+        const __m256i triples = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+        const __m256i bytes = _mm256_shuffle_epi8(triples, pack);
+        const __m256i packed = _mm256_permutevar8x32_epi32(bytes, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i / 4 * 3), packed);
+    }
+    return i + decode_base64_scalar(str + i, size - i, out + i / 4 * 3, url);
+}
+#endif
+
+inline constexpr kernel_family<std::size_t (*)(const uint8_t*, std::size_t, char*, bool)> BASE64_ENCODE_KERNELS{
+    "base64_encode", {&encode_base64_scalar, nullptr, STRUTIL_AVX2_KERNEL(&encode_base64_avx2), nullptr}};
+inline const bool BASE64_ENCODE_KERNELS_REGISTERED = register_kernel(BASE64_ENCODE_KERNELS);
+
+inline constexpr kernel_family<std::size_t (*)(const char*, std::size_t, uint8_t*, bool)> BASE64_DECODE_KERNELS{
+    "base64_decode", {&decode_base64_scalar, nullptr, STRUTIL_AVX2_KERNEL(&decode_base64_avx2), nullptr}};
+inline const bool BASE64_DECODE_KERNELS_REGISTERED = register_kernel(BASE64_DECODE_KERNELS);
+} // namespace detail
+
+/**
+ * @brief Returns the number of characters strutil::to_base64 produces for size bytes.
+ */
+inline std::size_t base64_encoded_size(std::size_t size, bool padding = true) {
+    return padding ? (size + 2) / 3 * 4 : size / 3 * 4 + (size % 3 == 0 ? 0 : size % 3 + 1);
+}
+
+/**
+ * @brief Returns an upper bound of the number of bytes strutil::from_base64 produces for size characters.
+ */
+inline std::size_t base64_decoded_size(std::size_t size) {
+    return size / 4 * 3 + (size % 4 > 1 ? size % 4 - 1 : 0);
+}
+
+/**
+ * @brief Encodes bytes as base64 into a caller-provided buffer.
+ *        Uses AVX2 when available (see strutil/dispatch.h), a table lookup per character otherwise.
+ * @param data - bytes to encode.
+ * @param size - number of bytes in data.
+ * @param out - destination with room for base64_encoded_size(size, padding) characters.
+ * @param alphabet - base64_alphabet::standard ("+/") or base64_alphabet::url ("-_").
+ * @param padding - pad the result with '=' to a multiple of 4 characters.
+ * @return Number of characters written.
+ */
+inline std::size_t to_base64_into(const uint8_t* data,
+                                  size_t size,
+                                  char* out,
+                                  base64_alphabet alphabet = base64_alphabet::standard,
+                                  bool padding = true) {
+    const detail::base64_table& table = alphabet == base64_alphabet::url ? detail::BASE64_URL : detail::BASE64_STANDARD;
+    const std::size_t i = detail::BASE64_ENCODE_KERNELS.get()(data, size, out, alphabet == base64_alphabet::url);
+    char* dst = out + i / 3 * 4;
+    if (i < size) {
+        const std::uint32_t rest = (std::uint32_t{data[i]} << 16) | (i + 1 < size ? std::uint32_t{data[i + 1]} << 8 : 0);
+        *dst++ = table.encode[rest >> 18];
+        *dst++ = table.encode[(rest >> 12) & 0x3F];
+        if (i + 1 < size) {
+            *dst++ = table.encode[(rest >> 6) & 0x3F];
+        } else if (padding) {
+            *dst++ = '=';
+        }
+        if (padding) {
+            *dst++ = '=';
+        }
+    }
+    return static_cast<std::size_t>(dst - out);
+}
+
+/**
+ * @brief Encodes bytes as base64.
+ * @param data - bytes to encode.
+ * @param size - number of bytes in data.
+ * @param alphabet - base64_alphabet::standard ("+/") or base64_alphabet::url ("-_").
+ * @param padding - pad the result with '=' to a multiple of 4 characters.
+ * @return The encoded string.
+ */
+inline std::string to_base64(const uint8_t* data,
+                             size_t size,
+                             base64_alphabet alphabet = base64_alphabet::standard,
+                             bool padding = true) {
+    STRUTIL_STATS_SCOPE(to_base64, size);
+    std::string result(base64_encoded_size(size, padding), '\0');
+    to_base64_into(data, size, result.data(), alphabet, padding);
+    STRUTIL_STATS_OUTPUT(result.size());
+    return result;
+}
+
+/**
+ * @brief Encodes the bytes of a string as base64.
+ */
+inline std::string to_base64(std::string_view bytes, base64_alphabet alphabet = base64_alphabet::standard, bool padding = true) {
+    return to_base64(reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size(), alphabet, padding);
+}
+
+/**
+ * @brief Decodes base64 into a caller-provided buffer. Validation is strict: only characters of the
+ *        given alphabet are accepted, '=' only as one or two padding characters completing the last
+ *        4-character group, and the unused low bits of the last character must be zero.
+ *        Unpadded input is accepted. Uses AVX2 when available, see strutil/dispatch.h.
+ * @param str - the base64 text.
+ * @param out - destination with room for base64_decoded_size(str.size()) bytes.
+ * @param written - receives the number of bytes written.
+ * @param alphabet - base64_alphabet::standard ("+/") or base64_alphabet::url ("-_").
+ * @return std::string_view::npos on success, otherwise the offset of the first invalid character.
+ */
+inline std::size_t from_base64_into(std::string_view str,
+                                    uint8_t* out,
+                                    std::size_t& written,
+                                    base64_alphabet alphabet = base64_alphabet::standard) {
+    const detail::base64_table& table = alphabet == base64_alphabet::url ? detail::BASE64_URL : detail::BASE64_STANDARD;
+    std::size_t size = str.size();
+    if (size % 4 == 0 && size != 0 && str[size - 1] == '=') {
+        size -= str[size - 2] == '=' ? 2 : 1;
+    }
+
+    const std::size_t i = detail::BASE64_DECODE_KERNELS.get()(str.data(), size, out, alphabet == base64_alphabet::url);
+    written = i / 4 * 3;
+    const auto decode = [&](std::size_t pos) { return table.decode[static_cast<unsigned char>(str[pos])]; };
+    if (size - i >= 4) {
+        // the kernel stopped at a group holding an invalid character
+        std::size_t pos = i;
+        while (decode(pos) != 0xFF) {
+            ++pos;
+        }
+        return pos;
+    }
+
+    const std::size_t rest = size - i;
+    if (rest == 0) {
+        return std::string_view::npos;
+    }
+    for (std::size_t pos = i; pos < size; ++pos) {
+        if (decode(pos) == 0xFF) {
+            return pos;
+        }
+    }
+    if (rest == 1) {
+        return i;
+    }
+    const std::uint32_t bits = (std::uint32_t{decode(i)} << 18) | (std::uint32_t{decode(i + 1)} << 12)
+                               | (rest == 3 ? std::uint32_t{decode(i + 2)} << 6 : 0);
+    if ((rest == 2 && (bits & 0xFFFF)) || (rest == 3 && (bits & 0xFF))) {
+        return size - 1;
+    }
+    out[written++] = static_cast<uint8_t>(bits >> 16);
+    if (rest == 3) {
+        out[written++] = static_cast<uint8_t>(bits >> 8);
+    }
+    return std::string_view::npos;
+}
+
+/**
+ * @brief Decodes base64 with the strict validation of strutil::from_base64_into.
+ * @param str - the base64 text.
+ * @param alphabet - base64_alphabet::standard ("+/") or base64_alphabet::url ("-_").
+ * @param error_offset - if not null, receives std::string_view::npos on success or the offset of the first invalid character.
+ * @return The decoded bytes, up to the 4-character group holding the first invalid character.
+ */
+inline std::vector<uint8_t> from_base64(std::string_view str,
+                                        base64_alphabet alphabet = base64_alphabet::standard,
+                                        std::size_t* error_offset = nullptr) {
+    STRUTIL_STATS_SCOPE(from_base64, str.size());
+    std::vector<uint8_t> bytes(base64_decoded_size(str.size()));
+    std::size_t written = 0;
+    const std::size_t offset = from_base64_into(str, bytes.data(), written, alphabet);
+    bytes.resize(written);
+    STRUTIL_STATS_OUTPUT(written);
+    if (error_offset != nullptr) {
+        *error_offset = offset;
+    }
+    return bytes;
+}
+
+/**
+ * @brief Escapes str the way strutil::preview does, without truncating: backslashes and
+ *        non-printable bytes become C escape sequences ("\\n", "\\t", "\\0", ..., or "\\xHH").
+ *        Runs of clean bytes are found with SIMD compares (see strutil/dispatch.h) and copied in bulk.
+ * @param str - the input string.
+ * @return The escaped string; strutil::unescape_c restores str from it.
+ */
+inline std::string escape_c(std::string_view str) {
+    STRUTIL_STATS_SCOPE(escape_c, str.size());
+    const detail::find_escape_fn find_escape = detail::C_ESCAPE_KERNELS.get();
+    std::string result;
+    result.reserve(str.size());
+    std::size_t pos = 0;
+    while (pos < str.size()) {
+        const std::size_t special = find_escape(str.data(), str.size(), pos);
+        result.append(str.data() + pos, special - pos);
+        if (special == str.size()) {
+            break;
+        }
+        detail::append_escaped(result, static_cast<unsigned char>(str[special]));
+        pos = special + 1;
+    }
+    STRUTIL_STATS_OUTPUT(result.size());
+    return result;
+}
+
+/**
+ * @brief Parses C escape sequences, the inverse of strutil::escape_c. Accepts "\\\\", "\\n", "\\r",
+ *        "\\t", "\\0", "\\b", "\\f", "\\v", "\\a", "\\\"", "\\'", "\\?" and "\\x" followed by exactly two
+ *        hexadecimal digits.
+ * @param str - the escaped text.
+ * @param error_offset - if not null, receives std::string_view::npos on success or the offset of the
+ *                       backslash starting the first malformed escape sequence.
+ * @return The unescaped string, up to the first malformed escape sequence.
+ */
+inline std::string unescape_c(std::string_view str, std::size_t* error_offset = nullptr) {
+    STRUTIL_STATS_SCOPE(unescape_c, str.size());
+    std::string result;
+    result.reserve(str.size());
+    std::size_t pos = 0;
+    std::size_t error = std::string_view::npos;
+    while (pos < str.size()) {
+        // std::string_view::find is a memchr, which already scans clean runs in vector-sized steps
+        const std::size_t backslash = std::min(str.find('\\', pos), str.size());
+        result.append(str.data() + pos, backslash - pos);
+        if (backslash == str.size()) {
+            break;
+        }
+        if (backslash + 1 == str.size()) {
+            error = backslash;
+            break;
+        }
+        char ch = '\0';
+        std::size_t length = 2;
+        switch (str[backslash + 1]) {
+            case '\\':
+                ch = '\\';
+                break;
+            case 'n':
+                ch = '\n';
+                break;
+            case 'r':
+                ch = '\r';
+                break;
+            case 't':
+                ch = '\t';
+                break;
+            case '0':
+                ch = '\0';
+                break;
+            case 'b':
+                ch = '\b';
+                break;
+            case 'f':
+                ch = '\f';
+                break;
+            case 'v':
+                ch = '\v';
+                break;
+            case 'a':
+                ch = '\a';
+                break;
+            case '"':
+                ch = '"';
+                break;
+            case '\'':
+                ch = '\'';
+                break;
+            case '?':
+                ch = '?';
+                break;
+            case 'x': {
+                const int high = backslash + 2 < str.size() ? detail::hex_digit_value(str[backslash + 2]) : -1;
+                const int low = backslash + 3 < str.size() ? detail::hex_digit_value(str[backslash + 3]) : -1;
+                if (high < 0 || low < 0) {
+                    length = 0;
+                    break;
+                }
+                ch = static_cast<char>(high << 4 | low);
+                length = 4;
+                break;
+            }
+            default:
+                length = 0;
+                break;
+        }
+        if (length == 0) {
+            error = backslash;
+            break;
+        }
+        result.push_back(ch);
+        pos = backslash + length;
+    }
+    if (error_offset != nullptr) {
+        *error_offset = error;
+    }
+    STRUTIL_STATS_OUTPUT(result.size());
+    return result;
+}
+
+/**
+ * @brief Escapes str for use inside a JSON string literal (RFC 8259), without adding the quotes:
+ *        '"' and backslashes are prefixed with a backslash, control characters become "\\b", "\\f",
+ *        "\\n", "\\r", "\\t" or "\\u00XX". Bytes >= 0x80 are copied unchanged, so UTF-8 stays UTF-8.
+ *        Runs of clean bytes are found with SIMD compares (see strutil/dispatch.h) and copied in bulk.
+ * @param str - the input string.
+ * @return The escaped string.
+ */
+inline std::string escape_json(std::string_view str) {
+    static constexpr char HEX_DIGITS[] = "0123456789abcdef";
+
+    STRUTIL_STATS_SCOPE(escape_json, str.size());
+    const detail::find_escape_fn find_escape = detail::JSON_ESCAPE_KERNELS.get();
+    std::string result;
+    result.reserve(str.size() + 2);
+    std::size_t pos = 0;
+    while (pos < str.size()) {
+        const std::size_t special = find_escape(str.data(), str.size(), pos);
+        result.append(str.data() + pos, special - pos);
+        if (special == str.size()) {
+            break;
+        }
+        const auto ch = static_cast<unsigned char>(str[special]);
+        switch (ch) {
+            case '"':
+                result.append("\\\"");
+                break;
+            case '\\':
+                result.append("\\\\");
+                break;
+            case '\b':
+                result.append("\\b");
+                break;
+            case '\f':
+                result.append("\\f");
+                break;
+            case '\n':
+                result.append("\\n");
+                break;
+            case '\r':
+                result.append("\\r");
+                break;
+            case '\t':
+                result.append("\\t");
+                break;
+            default: {
+                const char buffer[6] = {'\\', 'u', '0', '0', HEX_DIGITS[ch >> 4], HEX_DIGITS[ch & 0x0F]};
+                result.append(buffer, 6);
+                break;
+            }
+        }
+        pos = special + 1;
+    }
+    STRUTIL_STATS_OUTPUT(result.size());
+    return result;
+}
+
+} // namespace strutil
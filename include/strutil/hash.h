@@ -0,0 +1,306 @@
+/**
+******************************************************************************
+*
+*  @file       strutil/hash.h
+*  @brief      Non-cryptographic string hashing and transparent hash functors
+*
+******************************************************************************
+*/
+
+#pragma once
+
+#include "core.h"
+#include "dispatch.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace strutil {
+namespace detail {
+/**
+ * @brief Inputs of at least this many bytes take the striped long-input path of strutil::hash.
+ */
+inline constexpr std::size_t HASH_LONG_MIN = 256;
+
+inline constexpr std::uint64_t HASH_SECRET[4] = {
+    0xA0761D6478BD642Full, 0xE7037ED1A0B428DBull, 0x8EBC6AF09C88C6E3ull, 0x589965CC75374CC3ull};
+
+inline constexpr std::size_t HASH_STRIPE_KEY_COUNT = 23;
+
+// splitmix64 output; stripe s of a 16-stripe block uses words [s, s + 8), the scramble words [15, 23).
+// hash_stripes offsets them by the seed, so the keys themselves are seeded.
+inline constexpr std::uint64_t HASH_STRIPE_KEYS[HASH_STRIPE_KEY_COUNT] = {
+    0x2CB0F69F4ABEA221ull, 0x9417034723148989ull, 0xDD555950609DFE03ull, 0xDBAFB150DEB12800ull,
+    0x7E789B2E6C442CB6ull, 0xF41E5636C7E4F8C4ull, 0x0959D150F8FBA7E4ull, 0xA97316F13CDB9EEAull,
+    0x74CD8258F9520068ull, 0x55C74A62E116868Bull, 0xD2F4C799A2023CBDull, 0xDF98CB79A37B51B9ull,
+    0x396F5885524F3905ull, 0xAF1D56386CA3B276ull, 0xA9FFBE6B5104E85Aull, 0x6BD0C51B9FD533B3ull,
+    0x980CE91C50AB4B56ull, 0x28AC395780FE62C5ull, 0x768912E3A6BCEDC7ull, 0x50B3E8C9332C7C88ull,
+    0xCE3BBFE520BD47DAull, 0xCBA6C8E8E0BB7C4Full, 0xBF194DB8434A346Dull};
+
+/**
+ * @brief Loads 8 bytes as a little-endian integer, so hashes do not depend on the host byte order.
+ */
+inline std::uint64_t read_le64(const char* p) {
+    std::uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    value = __builtin_bswap64(value);
+#endif
+    return value;
+}
+
+/**
+ * @brief Loads 4 bytes as a little-endian integer.
+ */
+inline std::uint64_t read_le32(const char* p) {
+    std::uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    value = __builtin_bswap32(value);
+#endif
+    return value;
+}
+
+/**
+ * @brief Replaces a and b with the low and high halves of their 128-bit product.
+ */
+inline void multiply_128(std::uint64_t& a, std::uint64_t& b) {
+#if defined(__SIZEOF_INT128__)
+    __extension__ const unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+    a = static_cast<std::uint64_t>(product);
+    b = static_cast<std::uint64_t>(product >> 64);
+#else
+    const std::uint64_t a_lo = a & 0xFFFFFFFFu;
+    const std::uint64_t a_hi = a >> 32;
+    const std::uint64_t b_lo = b & 0xFFFFFFFFu;
+    const std::uint64_t b_hi = b >> 32;
+    const std::uint64_t lo_lo = a_lo * b_lo;
+    const std::uint64_t hi_lo = a_hi * b_lo;
+    const std::uint64_t lo_hi = a_lo * b_hi;
+    const std::uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFFu) + lo_hi;
+    a = (cross << 32) | (lo_lo & 0xFFFFFFFFu);
+    b = a_hi * b_hi + (hi_lo >> 32) + (cross >> 32);
+#endif
+}
+
+/**
+ * @brief Multiplies a and b into a 128-bit product and folds it to 64 bits by xoring both halves.
+ */
+inline std::uint64_t multiply_fold(std::uint64_t a, std::uint64_t b) {
+    multiply_128(a, b);
+    return a ^ b;
+}
+
+#if defined(__SSE2__)
+/**
+ * @brief Adds 16 bytes of a stripe to two accumulator lanes: each lane gains the 32x32-bit product
+ *        of the halves of (data ^ key) and the data word of the other lane.
+ */
+inline __m128i hash_accumulate_lanes(__m128i acc, const char* p, const std::uint64_t* key) {
+    const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    const __m128i keyed = _mm_xor_si128(data, _mm_loadu_si128(reinterpret_cast<const __m128i*>(key)));
+    const __m128i product = _mm_mul_epu32(keyed, _mm_shuffle_epi32(keyed, _MM_SHUFFLE(3, 3, 1, 1)));
+    const __m128i swapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+    return _mm_add_epi64(acc, _mm_add_epi64(product, swapped));
+}
+
+/**
+ * @brief Scrambles two accumulator lanes after a block of 16 stripes so that high bits reach the low half.
+ */
+inline __m128i hash_scramble_lanes(__m128i acc, const std::uint64_t* key) {
+    const __m128i multiplier = _mm_set1_epi32(static_cast<int>(0x9E3779B1u));
+    __m128i value = _mm_xor_si128(acc, _mm_srli_epi64(acc, 47));
+    value = _mm_xor_si128(value, _mm_loadu_si128(reinterpret_cast<const __m128i*>(key)));
+    const __m128i low = _mm_mul_epu32(value, multiplier);
+    const __m128i high = _mm_mul_epu32(_mm_srli_epi64(value, 32), multiplier);
+    return _mm_add_epi64(low, _mm_slli_epi64(high, 32));
+}
+#endif
+
+/**
+ * @brief Adds stripes 64-byte stripes of p to the eight accumulators, scrambling them after every
+ *        16 stripes, one 64-bit lane at a time. keys holds the HASH_STRIPE_KEY_COUNT seeded stripe keys.
+ */
+inline void accumulate_stripes_scalar(std::uint64_t* acc, const char* p, std::size_t stripes, const std::uint64_t* keys) {
+    const std::uint64_t* scramble_key = keys + 15;
+    for (std::size_t s = 0; s < stripes; ++s) {
+        const char* stripe = p + s * 64;
+        const std::uint64_t* key = keys + s % 16;
+        std::uint64_t data[8];
+        for (int i = 0; i < 8; ++i) {
+            data[i] = read_le64(stripe + i * 8);
+        }
+        for (int i = 0; i < 8; ++i) {
+            const std::uint64_t keyed = data[i] ^ key[i];
+            acc[i] += (keyed & 0xFFFFFFFFu) * (keyed >> 32) + data[i ^ 1];
+        }
+        if (s % 16 == 15) {
+            for (int i = 0; i < 8; ++i) {
+                const std::uint64_t value = acc[i] ^ (acc[i] >> 47) ^ scramble_key[i];
+                acc[i] = value * 0x9E3779B1u;
+            }
+        }
+    }
+}
+
+#if defined(__SSE2__)
+/**
+ * @brief SSE2 version of accumulate_stripes_scalar, two lanes per instruction; computes the same values.
+ */
+inline void accumulate_stripes_sse2(std::uint64_t* acc, const char* p, std::size_t stripes, const std::uint64_t* keys) {
+    const std::uint64_t* scramble_key = keys + 15;
+    __m128i* lanes = reinterpret_cast<__m128i*>(acc);
+    __m128i lanes0 = _mm_loadu_si128(lanes);
+    __m128i lanes1 = _mm_loadu_si128(lanes + 1);
+    __m128i lanes2 = _mm_loadu_si128(lanes + 2);
+    __m128i lanes3 = _mm_loadu_si128(lanes + 3);
+    for (std::size_t s = 0; s < stripes; ++s) {
+        const char* stripe = p + s * 64;
+        const std::uint64_t* key = keys + s % 16;
+        lanes0 = hash_accumulate_lanes(lanes0, stripe, key);
+        lanes1 = hash_accumulate_lanes(lanes1, stripe + 16, key + 2);
+        lanes2 = hash_accumulate_lanes(lanes2, stripe + 32, key + 4);
+        lanes3 = hash_accumulate_lanes(lanes3, stripe + 48, key + 6);
+        if (s % 16 == 15) {
+            lanes0 = hash_scramble_lanes(lanes0, scramble_key);
+            lanes1 = hash_scramble_lanes(lanes1, scramble_key + 2);
+            lanes2 = hash_scramble_lanes(lanes2, scramble_key + 4);
+            lanes3 = hash_scramble_lanes(lanes3, scramble_key + 6);
+        }
+    }
+    _mm_storeu_si128(lanes, lanes0);
+    _mm_storeu_si128(lanes + 1, lanes1);
+    _mm_storeu_si128(lanes + 2, lanes2);
+    _mm_storeu_si128(lanes + 3, lanes3);
+}
+#endif
+
+inline constexpr kernel_family<void (*)(std::uint64_t*, const char*, std::size_t, const std::uint64_t*)> HASH_STRIPE_KERNELS{
+    "hash", {&accumulate_stripes_scalar, STRUTIL_SSE2_KERNEL(&accumulate_stripes_sse2), nullptr, nullptr}};
+inline const bool HASH_STRIPE_KERNELS_REGISTERED = register_kernel(HASH_STRIPE_KERNELS);
+
+/**
+ * @brief Hashes all complete 64-byte stripes of p into eight independent accumulators and returns
+ *        them folded into one seed. Sets consumed to the number of bytes processed.
+ *        Like XXH3 with a seed, the stripe and scramble keys are HASH_STRIPE_KEYS plus the seed on even
+ *        words and minus it on odd ones; with fixed keys, inputs colliding under one seed would collide
+ *        under all of them.
+ */
+inline std::uint64_t hash_stripes(const char* p, std::size_t size, std::uint64_t seed, std::size_t& consumed) {
+    std::uint64_t keys[HASH_STRIPE_KEY_COUNT];
+    for (std::size_t i = 0; i < HASH_STRIPE_KEY_COUNT; ++i) {
+        keys[i] = i % 2 == 0 ? HASH_STRIPE_KEYS[i] + seed : HASH_STRIPE_KEYS[i] - seed;
+    }
+    std::uint64_t acc[8] = {seed ^ HASH_SECRET[0], seed + HASH_SECRET[1], seed ^ HASH_SECRET[2], seed + HASH_SECRET[3],
+                            seed ^ HASH_SECRET[1], seed + HASH_SECRET[0], seed ^ HASH_SECRET[3], seed + HASH_SECRET[2]};
+    const std::size_t stripes = size / 64;
+    HASH_STRIPE_KERNELS.get()(acc, p, stripes, keys);
+    consumed = stripes * 64;
+
+    std::uint64_t result = seed ^ (size * HASH_SECRET[0]);
+    for (int i = 0; i < 8; i += 2) {
+        result += multiply_fold(acc[i] ^ keys[i], acc[i + 1] ^ keys[i + 1]);
+    }
+    return result;
+}
+} // namespace detail
+
+/**
+ * @brief Fast non-cryptographic 64-bit hash of a string, in the style of wyhash: inputs up to 16 bytes
+ *        are hashed with two overlapping loads and one 128-bit multiply, medium inputs in 48-byte rounds
+ *        of three independent multiplies, and inputs of 256 bytes or more in 64-byte stripes over
+ *        eight accumulators (two lanes per SSE2 instruction when available).
+ *        The result is the same on every platform and with or without SSE2.
+ * @param str - bytes to hash.
+ * @param seed - seed value; use a random seed for tables fed with untrusted keys.
+ * @return 64-bit hash of str.
+ */
+inline std::uint64_t hash(std::string_view str, std::uint64_t seed = 0) {
+    using detail::HASH_SECRET;
+    using detail::multiply_fold;
+    using detail::read_le32;
+    using detail::read_le64;
+
+    const char* p = str.data();
+    const std::size_t size = str.size();
+    seed ^= multiply_fold(seed ^ HASH_SECRET[0], HASH_SECRET[1]);
+
+    std::uint64_t a = 0;
+    std::uint64_t b = 0;
+    if (size <= 16) {
+        if (size >= 4) {
+            const std::size_t middle = (size >> 3) << 2;
+            a = (read_le32(p) << 32) | read_le32(p + middle);
+            b = (read_le32(p + size - 4) << 32) | read_le32(p + size - 4 - middle);
+        } else if (size > 0) {
+            const auto byte = [p](std::size_t i) { return static_cast<std::uint64_t>(static_cast<unsigned char>(p[i])); };
+            a = (byte(0) << 16) | (byte(size >> 1) << 8) | byte(size - 1);
+        }
+    } else {
+        std::size_t left = size;
+        const char* tail = p;
+        if (size >= detail::HASH_LONG_MIN) {
+            std::size_t consumed = 0;
+            seed = detail::hash_stripes(p, size, seed, consumed);
+            tail += consumed;
+            left -= consumed;
+        } else if (left > 48) {
+            std::uint64_t seed1 = seed;
+            std::uint64_t seed2 = seed;
+            do {
+                seed = multiply_fold(read_le64(tail) ^ HASH_SECRET[1], read_le64(tail + 8) ^ seed);
+                seed1 = multiply_fold(read_le64(tail + 16) ^ HASH_SECRET[2], read_le64(tail + 24) ^ seed1);
+                seed2 = multiply_fold(read_le64(tail + 32) ^ HASH_SECRET[3], read_le64(tail + 40) ^ seed2);
+                tail += 48;
+                left -= 48;
+            } while (left > 48);
+            seed ^= seed1 ^ seed2;
+        }
+        while (left > 16) {
+            seed = multiply_fold(read_le64(tail) ^ HASH_SECRET[1], read_le64(tail + 8) ^ seed);
+            tail += 16;
+            left -= 16;
+        }
+        // the last 16 bytes of the input, which may overlap bytes hashed above
+        a = read_le64(p + size - 16);
+        b = read_le64(p + size - 8);
+    }
+
+    a ^= HASH_SECRET[1];
+    b ^= seed;
+    detail::multiply_128(a, b);
+    return multiply_fold(a ^ HASH_SECRET[0] ^ size, b ^ HASH_SECRET[1]);
+}
+
+/**
+ * @brief Transparent hash functor over strutil::hash. With std::equal_to<> as the key equality,
+ *        C++20 unordered containers keyed by std::string can be searched with std::string_view or
+ *        const char* without constructing a std::string:
+ *        std::unordered_map<std::string, V, strutil::hasher, std::equal_to<>>.
+ */
+class hasher {
+public:
+    using is_transparent = void;
+
+    hasher() noexcept = default;
+
+    /**
+     * @param seed - seed passed to strutil::hash.
+     */
+    explicit hasher(std::uint64_t seed) noexcept : seed_(seed) {}
+
+    std::size_t operator()(std::string_view str) const noexcept {
+        return static_cast<std::size_t>(hash(str, seed_));
+    }
+
+    std::uint64_t seed() const noexcept {
+        return seed_;
+    }
+
+private:
+    std::uint64_t seed_ = 0;
+};
+
+} // namespace strutil
@@ -0,0 +1,308 @@
+/**
+******************************************************************************
+*
+*  @file       strutil/intern.h
+*  @brief      String interning
+*
+******************************************************************************
+*/
+
+#pragma once
+
+#include "core.h"
+#include "hash.h"
+#include "split.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+namespace strutil {
+/**
+ * @brief Deduplicating string pool: maps every distinct string to a dense 32-bit id and a copy of it
+ *        in an append-only arena. Ids and views stay valid for the lifetime of the pool.
+ *        Lookup uses open addressing (linear probing) over (hash, id) slots, so most probes compare
+ *        a 32-bit hash tag instead of the string. Not thread-safe, see strutil::sharded_intern_pool.
+ */
+class intern_pool {
+public:
+    using id_type = std::uint32_t;
+
+    //! Largest number of distinct strings a pool can hold; the id 0xFFFFFFFF is reserved.
+    static constexpr std::size_t MAX_SIZE = 0xFFFFFFFFu;
+
+    /**
+     * @param chunk_size - size of the arena chunks holding the string bytes.
+     * @param max_size - number of distinct strings after which intern throws, at most MAX_SIZE.
+     */
+    explicit intern_pool(std::size_t chunk_size = 64 * 1024, std::size_t max_size = MAX_SIZE)
+        : chunk_size_(chunk_size), max_size_(std::min(max_size, MAX_SIZE)) {}
+
+    intern_pool(const intern_pool&) = delete;
+    intern_pool& operator=(const intern_pool&) = delete;
+    intern_pool(intern_pool&&) = default;
+    intern_pool& operator=(intern_pool&&) = default;
+
+    /**
+     * @brief Returns the id of str, adding a copy of it to the pool if it is not there yet.
+     * @throws std::length_error if str is new and the pool already holds max_size strings.
+     */
+    id_type intern(std::string_view str) {
+        return intern(str, strutil::hash(str));
+    }
+
+    /**
+     * @brief Same as intern(str), with the hash precomputed by strutil::hash.
+     * @throws std::length_error if str is new and the pool already holds max_size strings.
+     */
+    id_type intern(std::string_view str, std::uint64_t hash) {
+        if ((strings_.size() + 1) * 2 > slots_.size()) {
+            grow();
+        }
+
+        const auto tag = static_cast<std::uint32_t>(hash >> 32);
+        slot& s = slots_[probe(str, hash, tag)];
+        if (s.id == EMPTY) {
+            if (strings_.size() >= max_size_) {
+                throw std::length_error("strutil::intern_pool: too many distinct strings for 32-bit ids");
+            }
+            s.tag = tag;
+            s.id = static_cast<id_type>(strings_.size());
+            strings_.push_back(store(str));
+            tags_.push_back(tag);
+        }
+        return s.id;
+    }
+
+    /**
+     * @brief Looks up str without adding it.
+     * @param str - string to look up.
+     * @param id - receives the id of str if it is in the pool.
+     * @return True if str is in the pool.
+     */
+    bool find(std::string_view str, id_type& id) const {
+        if (slots_.empty()) {
+            return false;
+        }
+        const std::uint64_t str_hash = strutil::hash(str);
+        id = slots_[probe(str, str_hash, static_cast<std::uint32_t>(str_hash >> 32))].id;
+        return id != EMPTY;
+    }
+
+    /**
+     * @brief Returns the pooled copy of the string with the given id.
+     */
+    std::string_view view(id_type id) const {
+        return strings_[id];
+    }
+
+    /**
+     * @brief Returns the number of distinct strings in the pool.
+     */
+    std::size_t size() const {
+        return strings_.size();
+    }
+
+private:
+    static constexpr id_type EMPTY = 0xFFFFFFFFu;
+
+    struct slot {
+        std::uint32_t tag;
+        id_type id;
+    };
+
+    std::size_t probe(std::string_view str, std::uint64_t hash, std::uint32_t tag) const {
+        const std::size_t mask = slots_.size() - 1;
+        std::size_t index = static_cast<std::size_t>(hash) & mask;
+        while (true) {
+            const slot& s = slots_[index];
+            if (s.id == EMPTY || (s.tag == tag && strings_[s.id] == str)) {
+                return index;
+            }
+            index = (index + 1) & mask;
+        }
+    }
+
+    void grow() {
+        std::vector<slot> slots(std::max<std::size_t>(16, slots_.size() * 2), slot{0, EMPTY});
+        const std::size_t mask = slots.size() - 1;
+        for (id_type id = 0; id < strings_.size(); ++id) {
+            // the low hash bits are not kept, rehash the string to find its home slot
+            std::size_t index = static_cast<std::size_t>(strutil::hash(strings_[id])) & mask;
+            while (slots[index].id != EMPTY) {
+                index = (index + 1) & mask;
+            }
+            slots[index] = slot{tags_[id], id};
+        }
+        slots_ = std::move(slots);
+    }
+
+    std::string_view store(std::string_view str) {
+        if (str.empty()) {
+            return std::string_view();
+        }
+        if (str.size() > chunk_remaining_) {
+            if (str.size() * 4 > chunk_size_) {
+                // large strings get an exactly sized allocation of their own so the current chunk is not wasted
+                chunks_.emplace_back(new char[str.size()]);
+                std::memcpy(chunks_.back().get(), str.data(), str.size());
+                return std::string_view(chunks_.back().get(), str.size());
+            }
+            chunks_.emplace_back(new char[chunk_size_]);
+            chunk_cursor_ = chunks_.back().get();
+            chunk_remaining_ = chunk_size_;
+        }
+        char* copy = chunk_cursor_;
+        std::memcpy(copy, str.data(), str.size());
+        chunk_cursor_ += str.size();
+        chunk_remaining_ -= str.size();
+        return std::string_view(copy, str.size());
+    }
+
+    std::size_t chunk_size_;
+    std::size_t max_size_;
+    std::vector<std::unique_ptr<char[]>> chunks_;
+    char* chunk_cursor_ = nullptr;
+    std::size_t chunk_remaining_ = 0;
+    std::vector<std::string_view> strings_;
+    std::vector<std::uint32_t> tags_;
+    std::vector<slot> slots_;
+};
+
+/**
+ * @brief Thread-safe strutil::intern_pool for concurrent producers. Strings are distributed over
+ *        independently locked shards by hash, so threads interning different strings rarely contend.
+ *        The shard index is stored in the low bits of the id.
+ */
+class sharded_intern_pool {
+public:
+    using id_type = intern_pool::id_type;
+
+    /**
+     * @param shard_bits - log2 of the number of shards, less than 32.
+     */
+    explicit sharded_intern_pool(unsigned shard_bits = 4) : shard_bits_(shard_bits), shards_(std::size_t{1} << shard_bits) {
+        // the shard index takes shard_bits of the id, so every shard gets the remaining range
+        for (shard& s : shards_) {
+            s.pool = intern_pool(64 * 1024, intern_pool::MAX_SIZE >> shard_bits);
+        }
+    }
+
+    /**
+     * @brief Returns the id of str, adding a copy of it to the pool if it is not there yet.
+     * @throws std::length_error if str is new and its shard has run out of ids.
+     */
+    id_type intern(std::string_view str) {
+        const std::uint64_t str_hash = strutil::hash(str);
+        const std::size_t index = shard_index(str_hash);
+        shard& s = shards_[index];
+
+        id_type local_id;
+        {
+            std::shared_lock<std::shared_mutex> lock(s.mutex);
+            if (s.pool.find(str, local_id)) {
+                return to_global(local_id, index);
+            }
+        }
+        std::unique_lock<std::shared_mutex> lock(s.mutex);
+        return to_global(s.pool.intern(str, str_hash), index);
+    }
+
+    /**
+     * @brief Looks up str without adding it.
+     * @param str - string to look up.
+     * @param id - receives the id of str if it is in the pool.
+     * @return True if str is in the pool.
+     */
+    bool find(std::string_view str, id_type& id) const {
+        const std::size_t index = shard_index(strutil::hash(str));
+        const shard& s = shards_[index];
+        std::shared_lock<std::shared_mutex> lock(s.mutex);
+        id_type local_id;
+        if (!s.pool.find(str, local_id)) {
+            return false;
+        }
+        id = to_global(local_id, index);
+        return true;
+    }
+
+    /**
+     * @brief Returns the pooled copy of the string with the given id.
+     */
+    std::string_view view(id_type id) const {
+        const shard& s = shards_[id & ((id_type{1} << shard_bits_) - 1)];
+        std::shared_lock<std::shared_mutex> lock(s.mutex);
+        return s.pool.view(id >> shard_bits_);
+    }
+
+    /**
+     * @brief Returns the number of distinct strings in the pool.
+     */
+    std::size_t size() const {
+        std::size_t total = 0;
+        for (const auto& s : shards_) {
+            std::shared_lock<std::shared_mutex> lock(s.mutex);
+            total += s.pool.size();
+        }
+        return total;
+    }
+
+private:
+    struct shard {
+        mutable std::shared_mutex mutex;
+        intern_pool pool;
+    };
+
+    std::size_t shard_index(std::uint64_t hash) const {
+        // the intern_pool picks home slots from the low bits, which a table of at most 2^33 slots never
+        // takes up to the top ones; the shard's strings then share the top shard_bits of their 32-bit tag
+        return shard_bits_ == 0 ? 0 : static_cast<std::size_t>(hash >> (64 - shard_bits_));
+    }
+
+    // local ids stay below 2^(32 - shard_bits) - 1 (see the constructor), so the shift cannot overflow
+    id_type to_global(id_type local_id, std::size_t index) const {
+        return (local_id << shard_bits_) | static_cast<id_type>(index);
+    }
+
+    unsigned shard_bits_;
+    std::vector<shard> shards_;
+};
+
+/**
+ * @brief Splits input string according to input character delimiter and interns every token.
+ * @tparam Pool - strutil::intern_pool or strutil::sharded_intern_pool.
+ * @param s - string that will be splitted.
+ * @param delim - the delimiter.
+ * @param pool - pool receiving the tokens.
+ * @return Ids of the tokens in input order.
+ */
+template<typename Pool>
+std::vector<std::uint32_t> split_interned(std::string_view s, const char delim, Pool& pool) {
+    std::vector<std::uint32_t> ids;
+    ids.reserve(1u + static_cast<std::size_t>(std::count(s.begin(), s.end(), delim)));
+    detail::split_each(s, delim, [&](std::string_view token) { ids.push_back(pool.intern(token)); });
+    return ids;
+}
+
+/**
+ * @brief Splits input string according to input delimiter substring and interns every token.
+ * @tparam Pool - strutil::intern_pool or strutil::sharded_intern_pool.
+ * @param str - string that will be split.
+ * @param delim - the delimiter.
+ * @param pool - pool receiving the tokens.
+ * @return Ids of the tokens in input order.
+ */
+template<typename Pool>
+std::vector<std::uint32_t> split_interned(std::string_view str, std::string_view delim, Pool& pool) {
+    std::vector<std::uint32_t> ids;
+    detail::split_each(str, delim, [&](std::string_view token) { ids.push_back(pool.intern(token)); });
+    return ids;
+}
+
+} // namespace strutil
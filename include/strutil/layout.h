@@ -0,0 +1,229 @@
+/**
+******************************************************************************
+*
+*  @file       strutil/layout.h
+*  @brief      Word wrapping and padding for console text, measured in bytes or UTF-8 code points
+*
+******************************************************************************
+*/
+
+#pragma once
+
+#include "core.h"
+#include "utf8.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace strutil {
+/**
+ * @brief Options of strutil::wrap and strutil::wrap_into.
+ */
+struct wrap_options {
+    //! Prefix of every line after the first (hanging indent); it takes up width on those lines.
+    std::string_view indent;
+    //! Measure widths in UTF-8 code points instead of bytes.
+    bool utf8 = true;
+    //! Cut words wider than a line into line-sized pieces instead of overflowing the line.
+    bool break_long_words = true;
+};
+
+namespace detail {
+inline bool is_wrap_space(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+/**
+ * @brief Lays str out in lines of at most width columns and calls on_line(line, line_index) with each
+ *        line, a view into str. Words are separated by spaces and tabs, which are dropped at line breaks
+ *        and kept inside a line; '\n' forces a break and blank lines are kept. Every byte is visited a
+ *        constant number of times, so the time is linear in str.size().
+ */
+template<typename OnLine>
+void wrap_each(std::string_view str, std::size_t width, const wrap_options& options, OnLine&& on_line) {
+    const std::size_t indent_width = options.utf8 ? utf8_length(options.indent) : options.indent.size();
+    const std::size_t rest_width = std::max<std::size_t>(width > indent_width ? width - indent_width : 0, 1);
+    const std::size_t first_width = std::max<std::size_t>(width, 1);
+
+    std::size_t line_index = 0;
+    const auto emit = [&](std::size_t begin, std::size_t end) {
+        on_line(str.substr(begin, end - begin), line_index);
+        ++line_index;
+    };
+    const auto available = [&]() {
+        return line_index == 0 ? first_width : rest_width;
+    };
+
+    std::size_t pos = 0;
+    while (pos < str.size()) {
+        const std::size_t paragraph_end = std::min(str.find('\n', pos), str.size());
+        std::size_t line_begin = std::string_view::npos;
+        std::size_t line_end = 0;
+        std::size_t line_width = 0;
+        std::size_t i = pos;
+        while (true) {
+            while (i < paragraph_end && is_wrap_space(str[i])) {
+                ++i;
+            }
+            if (i == paragraph_end) {
+                break;
+            }
+            std::size_t word_begin = i;
+            std::size_t word_width = 0;
+            for (; i < paragraph_end && !is_wrap_space(str[i]); ++i) {
+                word_width += !options.utf8 || (static_cast<unsigned char>(str[i]) & 0xC0) != 0x80;
+            }
+
+            if (line_begin != std::string_view::npos) {
+                // the spaces between the words are ASCII, one column each
+                const std::size_t extended = line_width + (word_begin - line_end) + word_width;
+                if (extended <= available()) {
+                    line_end = i;
+                    line_width = extended;
+                    continue;
+                }
+                emit(line_begin, line_end);
+            }
+            while (options.break_long_words && word_width > available()) {
+                const std::size_t columns = available();
+                const std::string_view word = str.substr(word_begin, i - word_begin);
+                const std::size_t cut = options.utf8 ? utf8_offset(word, columns) : columns;
+                emit(word_begin, word_begin + cut);
+                word_begin += cut;
+                word_width -= columns;
+            }
+            line_begin = word_begin;
+            line_end = i;
+            line_width = word_width;
+        }
+
+        if (line_begin != std::string_view::npos) {
+            emit(line_begin, line_end);
+        } else {
+            emit(paragraph_end, paragraph_end);
+        }
+        pos = paragraph_end + 1;
+    }
+}
+
+/**
+ * @brief Appends width - str_width copies of fill, if str_width is less than width.
+ */
+inline void append_fill(std::string& out, std::size_t str_width, std::size_t width, char fill) {
+    if (str_width < width) {
+        out.append(width - str_width, fill);
+    }
+}
+} // namespace detail
+
+/**
+ * @brief Wraps str into lines of at most width columns in a single pass, without copying it.
+ *        Words are separated by spaces and tabs, which are dropped where a line breaks; '\n' forces a
+ *        break. Lines after the first leave room for options.indent, which the caller prepends.
+ * @param str - text to wrap; must outlive the result.
+ * @param width - maximum line width in code points (or bytes, see strutil::wrap_options).
+ * @param options - see strutil::wrap_options.
+ * @return std::vector<std::string_view> of lines pointing into str; empty if str is empty.
+ */
+inline std::vector<std::string_view> wrap(std::string_view str, std::size_t width, const wrap_options& options = wrap_options()) {
+    std::vector<std::string_view> lines;
+    detail::wrap_each(str, width, options, [&](std::string_view line, std::size_t) { lines.push_back(line); });
+    return lines;
+}
+
+/**
+ * @brief Wraps str like strutil::wrap and appends the lines to out, separated by '\n' and with
+ *        options.indent in front of every non-empty line after the first. No trailing '\n' is added.
+ * @param str - text to wrap.
+ * @param width - maximum line width including the indent, in code points (or bytes, see strutil::wrap_options).
+ * @param out - the wrapped text is appended to it.
+ * @param options - see strutil::wrap_options.
+ */
+inline void wrap_into(std::string_view str, std::size_t width, std::string& out, const wrap_options& options = wrap_options()) {
+    const std::size_t estimated_lines = str.size() / std::max<std::size_t>(width, 1) + 1;
+    out.reserve(out.size() + str.size() + estimated_lines * (options.indent.size() + 1));
+    detail::wrap_each(str, width, options, [&](std::string_view line, std::size_t line_index) {
+        if (line_index != 0) {
+            out.push_back('\n');
+            if (!line.empty()) {
+                out.append(options.indent);
+            }
+        }
+        out.append(line);
+    });
+}
+
+/**
+ * @brief Appends str to out, right-aligned in a field of width UTF-8 code points.
+ * @param str - text to pad; appended as it is if it is already width or more code points long.
+ * @param width - field width in code points.
+ * @param out - the padded text is appended to it, so one reserved buffer can hold a whole table.
+ * @param fill - padding character.
+ */
+inline void pad_left_into(std::string_view str, std::size_t width, std::string& out, char fill = ' ') {
+    detail::append_fill(out, utf8_length(str), width, fill);
+    out.append(str);
+}
+
+/**
+ * @brief Appends str to out, left-aligned in a field of width UTF-8 code points.
+ * @param str - text to pad; appended as it is if it is already width or more code points long.
+ * @param width - field width in code points.
+ * @param out - the padded text is appended to it.
+ * @param fill - padding character.
+ */
+inline void pad_right_into(std::string_view str, std::size_t width, std::string& out, char fill = ' ') {
+    out.append(str);
+    detail::append_fill(out, utf8_length(str), width, fill);
+}
+
+/**
+ * @brief Appends str to out, centered in a field of width UTF-8 code points. When the padding is
+ *        odd, the extra fill character goes to the right.
+ * @param str - text to pad; appended as it is if it is already width or more code points long.
+ * @param width - field width in code points.
+ * @param out - the padded text is appended to it.
+ * @param fill - padding character.
+ */
+inline void center_into(std::string_view str, std::size_t width, std::string& out, char fill = ' ') {
+    const std::size_t str_width = utf8_length(str);
+    const std::size_t padding = str_width < width ? width - str_width : 0;
+    out.append(padding / 2, fill);
+    out.append(str);
+    out.append(padding - padding / 2, fill);
+}
+
+/**
+ * @brief Right-aligns str in a field of width UTF-8 code points, see strutil::pad_left_into.
+ */
+inline std::string pad_left(std::string_view str, std::size_t width, char fill = ' ') {
+    std::string result;
+    result.reserve(str.size() + width);
+    pad_left_into(str, width, result, fill);
+    return result;
+}
+
+/**
+ * @brief Left-aligns str in a field of width UTF-8 code points, see strutil::pad_right_into.
+ */
+inline std::string pad_right(std::string_view str, std::size_t width, char fill = ' ') {
+    std::string result;
+    result.reserve(str.size() + width);
+    pad_right_into(str, width, result, fill);
+    return result;
+}
+
+/**
+ * @brief Centers str in a field of width UTF-8 code points, see strutil::center_into.
+ */
+inline std::string center(std::string_view str, std::size_t width, char fill = ' ') {
+    std::string result;
+    result.reserve(str.size() + width);
+    center_into(str, width, result, fill);
+    return result;
+}
+
+} // namespace strutil
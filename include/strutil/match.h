@@ -0,0 +1,599 @@
+/**
+******************************************************************************
+*
+*  @file       strutil/match.h
+*  @brief      Edit distance, fuzzy matching and glob patterns
+*
+******************************************************************************
+*/
+
+#pragma once
+
+#include "core.h"
+
+#include <algorithm>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace strutil {
+namespace detail {
+/**
+ * @brief Preprocessed pattern for Myers' bit-parallel edit distance (in Hyyrö's block formulation):
+ *        one 64-bit match mask per pattern block and byte value, so a column of the dynamic programming
+ *        matrix is advanced 64 rows at a time.
+ */
+class myers_pattern {
+public:
+    explicit myers_pattern(std::string_view pattern)
+        : length_(pattern.size()), blocks_((pattern.size() + 63) / 64), peq_(blocks_ * 256, 0) {
+        for (std::size_t i = 0; i < pattern.size(); ++i) {
+            peq_[(i / 64) * 256 + static_cast<unsigned char>(pattern[i])] |= std::uint64_t{1} << (i % 64);
+        }
+    }
+
+    /**
+     * @brief Computes the Levenshtein distance between the pattern and text.
+     * @param text - string to compare with.
+     * @param max_distance - stop as soon as the distance is known to exceed it.
+     * @return The distance, or a value greater than max_distance if it exceeds max_distance.
+     */
+    std::size_t distance(std::string_view text, std::size_t max_distance = std::string_view::npos) const {
+        const std::size_t length_difference = length_ > text.size() ? length_ - text.size() : text.size() - length_;
+        if (length_difference > max_distance) {
+            return max_distance + 1;
+        }
+        if (length_ == 0) {
+            return text.size();
+        }
+        if (blocks_ == 1) {
+            return distance_single_word(text, max_distance);
+        }
+
+        std::vector<std::uint64_t> positive(blocks_, ~std::uint64_t{0});
+        std::vector<std::uint64_t> negative(blocks_, 0);
+        const std::uint64_t last_bit = std::uint64_t{1} << ((length_ - 1) % 64);
+        std::size_t score = length_;
+        for (std::size_t j = 0; j < text.size(); ++j) {
+            const std::uint64_t* peq = peq_.data() + static_cast<unsigned char>(text[j]);
+            int carry = 1; // the top row grows by one per column
+            for (std::size_t w = 0; w < blocks_; ++w) {
+                carry = advance_block(positive[w], negative[w], peq[w * 256], carry,
+                                      w + 1 == blocks_ ? last_bit : std::uint64_t{1} << 63);
+            }
+            score = static_cast<std::size_t>(static_cast<std::ptrdiff_t>(score) + carry);
+
+            // the distance can shrink by at most one per remaining column
+            if (score > max_distance && score - max_distance > text.size() - j - 1) {
+                return max_distance + 1;
+            }
+        }
+        return score;
+    }
+
+private:
+    /**
+     * @brief Advances one 64-row block of the current column.
+     * @param positive - vertical +1 deltas of the block, updated in place.
+     * @param negative - vertical -1 deltas of the block, updated in place.
+     * @param eq - match mask of the current text character for this block.
+     * @param carry_in - horizontal delta (-1, 0, +1) entering the block from above.
+     * @param high_bit - bit of the last row of the block.
+     * @return Horizontal delta leaving the block at its last row.
+     */
+    static int advance_block(std::uint64_t& positive, std::uint64_t& negative, std::uint64_t eq, int carry_in, std::uint64_t high_bit) {
+        const std::uint64_t xv = eq | negative;
+        if (carry_in < 0) {
+            eq |= 1;
+        }
+        const std::uint64_t xh = (((eq & positive) + positive) ^ positive) | eq;
+        std::uint64_t ph = negative | ~(xh | positive);
+        std::uint64_t mh = positive & xh;
+
+        int carry_out = 0;
+        if (ph & high_bit) {
+            carry_out = 1;
+        } else if (mh & high_bit) {
+            carry_out = -1;
+        }
+
+        ph <<= 1;
+        mh <<= 1;
+        if (carry_in < 0) {
+            mh |= 1;
+        } else if (carry_in > 0) {
+            ph |= 1;
+        }
+        positive = mh | ~(xv | ph);
+        negative = ph & xv;
+        return carry_out;
+    }
+
+    std::size_t distance_single_word(std::string_view text, std::size_t max_distance) const {
+        std::uint64_t positive = ~std::uint64_t{0};
+        std::uint64_t negative = 0;
+        const std::uint64_t last_bit = std::uint64_t{1} << (length_ - 1);
+        std::size_t score = length_;
+        for (std::size_t j = 0; j < text.size(); ++j) {
+            score = static_cast<std::size_t>(static_cast<std::ptrdiff_t>(score)
+                                             + advance_block(positive, negative, peq_[static_cast<unsigned char>(text[j])], 1, last_bit));
+            if (score > max_distance && score - max_distance > text.size() - j - 1) {
+                return max_distance + 1;
+            }
+        }
+        return score;
+    }
+
+    std::size_t length_;
+    std::size_t blocks_;
+    std::vector<std::uint64_t> peq_;
+};
+} // namespace detail
+
+/**
+ * @brief Computes the Levenshtein (edit) distance between two strings: the minimal number of single-byte
+ *        insertions, deletions and substitutions turning one into the other.
+ *        Uses Myers' bit-parallel algorithm, O(ceil(m / 64) * n) for the shorter length m.
+ * @param str1 - string to compare
+ * @param str2 - string to compare
+ * @return The edit distance.
+ */
+inline std::size_t levenshtein_distance(std::string_view str1, std::string_view str2) {
+    if (str1.size() > str2.size()) {
+        std::swap(str1, str2);
+    }
+    return detail::myers_pattern(str1).distance(str2);
+}
+
+/**
+ * @brief Checks if the Levenshtein distance between two strings is at most max_distance.
+ *        Stops as soon as the bound can no longer be met, so dissimilar strings are rejected early.
+ * @param str1 - string to compare
+ * @param str2 - string to compare
+ * @param max_distance - the largest accepted distance.
+ * @return True if levenshtein_distance(str1, str2) <= max_distance.
+ */
+inline bool within_distance(std::string_view str1, std::string_view str2, std::size_t max_distance) {
+    if (str1.size() > str2.size()) {
+        std::swap(str1, str2);
+    }
+    if (str2.size() - str1.size() > max_distance) {
+        return false;
+    }
+    return detail::myers_pattern(str1).distance(str2, max_distance) <= max_distance;
+}
+
+/**
+ * @brief Typo-tolerant lookup of one query against many candidates. The query is preprocessed once,
+ *        each candidate costs one bit-parallel edit distance pass that stops early once it cannot
+ *        beat the current k-th best match.
+ */
+class fuzzy_matcher {
+public:
+    /**
+     * @brief A dictionary entry matched by strutil::fuzzy_matcher::top_k.
+     */
+    struct match {
+        std::size_t index;    //!< position of the entry in the dictionary
+        std::size_t distance; //!< edit distance between the query and the entry
+    };
+
+    /**
+     * @param query - the string to look up.
+     */
+    explicit fuzzy_matcher(std::string_view query) : pattern_(query) {}
+
+    /**
+     * @brief Returns the Levenshtein distance between the query and candidate.
+     */
+    std::size_t distance(std::string_view candidate) const {
+        return pattern_.distance(candidate);
+    }
+
+    /**
+     * @brief Checks if the Levenshtein distance between the query and candidate is at most max_distance.
+     */
+    bool within(std::string_view candidate, std::size_t max_distance) const {
+        return pattern_.distance(candidate, max_distance) <= max_distance;
+    }
+
+    /**
+     * @brief Finds the k dictionary entries closest to the query.
+     * @tparam Container - random access container of strings or string views.
+     * @param dictionary - the candidates.
+     * @param k - number of matches to return.
+     * @param max_distance - ignore entries farther than this.
+     * @param threads - number of threads scanning disjoint slices of the dictionary.
+     * @return Up to k matches ordered by distance, then by dictionary index.
+     */
+    template<typename Container>
+    std::vector<match> top_k(const Container& dictionary,
+                             std::size_t k,
+                             std::size_t max_distance = std::string_view::npos,
+                             unsigned threads = 1) const {
+        if (k == 0 || dictionary.empty()) {
+            return {};
+        }
+        threads = std::max(1u, std::min<unsigned>(threads, static_cast<unsigned>(dictionary.size())));
+
+        const std::size_t slice = (dictionary.size() + threads - 1) / threads;
+        std::vector<std::vector<match>> partial(threads);
+        const auto scan = [&](unsigned t) {
+            const std::size_t end = std::min(dictionary.size(), (t + 1) * slice);
+            for (std::size_t i = t * slice; i < end; ++i) {
+                std::vector<match>& best = partial[t];
+                const std::size_t bound = best.size() < k ? max_distance : std::min(max_distance, best.front().distance);
+                const std::size_t d = pattern_.distance(std::string_view(dictionary[i]), bound);
+                if (d > bound || (best.size() == k && d == bound)) {
+                    continue;
+                }
+                best.push_back({i, d});
+                std::push_heap(best.begin(), best.end(), &fuzzy_matcher::closer);
+                if (best.size() > k) {
+                    std::pop_heap(best.begin(), best.end(), &fuzzy_matcher::closer);
+                    best.pop_back();
+                }
+            }
+        };
+
+        if (threads == 1) {
+            scan(0);
+        } else {
+            std::vector<std::thread> workers;
+            for (unsigned t = 0; t < threads; ++t) {
+                workers.emplace_back(scan, t);
+            }
+            for (auto& worker : workers) {
+                worker.join();
+            }
+        }
+
+        std::vector<match> result;
+        for (const auto& best : partial) {
+            result.insert(result.end(), best.begin(), best.end());
+        }
+        std::sort(result.begin(), result.end(), &fuzzy_matcher::closer);
+        if (result.size() > k) {
+            result.resize(k);
+        }
+        return result;
+    }
+
+private:
+    static bool closer(const match& lhs, const match& rhs) {
+        return lhs.distance != rhs.distance ? lhs.distance < rhs.distance : lhs.index < rhs.index;
+    }
+
+    detail::myers_pattern pattern_;
+};
+
+/**
+ * @brief Wildcard pattern compiled once for fast repeated matching. Supports '*' (any sequence of
+ *        characters, including none), '?' (any single character), character classes such as "[abc]",
+ *        "[a-z]" and negated "[!a-z]" / "[^a-z]", and '\' escaping the next character.
+ *        '*' also matches '/', patterns are matched against the whole input.
+ *
+ *        The pattern is split at '*' into fixed-length segments. The first and last segments are anchored
+ *        to the ends of the input, the middle ones are searched leftmost-first in order, which never needs
+ *        backtracking. Each middle segment is found with a bit-parallel Shift-And scan over per-byte atom
+ *        masks, a single pass in O(n * ceil(m / 64)) for a segment of m atoms; while no partial match is
+ *        pending, the scan skips to the next occurrence of a literal first atom with memchr.
+ */
+class glob_pattern {
+public:
+    /**
+     * @param pattern - the wildcard pattern.
+     */
+    explicit glob_pattern(std::string_view pattern) : pattern_(pattern) {
+        segments_.emplace_back();
+        for (std::size_t i = 0; i < pattern.size(); ++i) {
+            const char c = pattern[i];
+            if (c == '*') {
+                segments_.emplace_back();
+            } else if (c == '?') {
+                add_atom({atom::ANY, 0, 0});
+            } else if (c == '[' && parse_class(pattern, i)) {
+                // parse_class added the atom and advanced i to the closing ']'
+            } else if (c == '\\' && i + 1 < pattern.size()) {
+                add_atom({atom::LITERAL, pattern[++i], 0});
+            } else {
+                add_atom({atom::LITERAL, c, 0});
+            }
+        }
+
+        for (auto& s : segments_) {
+            for (const auto& a : s.atoms) {
+                if (a.kind != atom::LITERAL) {
+                    break;
+                }
+                s.literal_head.push_back(a.c);
+            }
+        }
+        // only the middle segments are searched for
+        for (std::size_t i = 1; i + 1 < segments_.size(); ++i) {
+            build_shift_masks(segments_[i]);
+        }
+    }
+
+    /**
+     * @brief Checks if the whole str matches the pattern.
+     */
+    bool matches(std::string_view str) const {
+        const segment& first = segments_.front();
+        if (segments_.size() == 1) {
+            return str.size() == first.atoms.size() && match_at(first, str, 0);
+        }
+
+        const segment& last = segments_.back();
+        if (str.size() < first.atoms.size() + last.atoms.size()
+            || !match_at(first, str, 0)
+            || !match_at(last, str, str.size() - last.atoms.size())) {
+            return false;
+        }
+
+        std::size_t pos = first.atoms.size();
+        const std::size_t end = str.size() - last.atoms.size();
+        for (std::size_t i = 1; i + 1 < segments_.size(); ++i) {
+            const std::size_t found = find_segment(segments_[i], str.substr(0, end), pos);
+            if (found == std::string_view::npos) {
+                return false;
+            }
+            pos = found + segments_[i].atoms.size();
+        }
+        return true;
+    }
+
+    /**
+     * @brief Returns the literal text every matching string starts with.
+     */
+    std::string_view literal_prefix() const {
+        return segments_.front().literal_head;
+    }
+
+    /**
+     * @brief Returns the source pattern.
+     */
+    const std::string& pattern() const {
+        return pattern_;
+    }
+
+private:
+    struct atom {
+        enum kind_type { LITERAL, ANY, CLASS };
+        kind_type kind;
+        char c;
+        std::size_t class_index;
+    };
+
+    struct segment {
+        std::vector<atom> atoms;
+        std::string literal_head;
+        //! Shift-And masks: word w of byte c has bit j set if atom 64 * w + j accepts c.
+        std::vector<std::uint64_t> shift_masks;
+        std::size_t words = 0;
+    };
+
+    void add_atom(const atom& a) {
+        segments_.back().atoms.push_back(a);
+    }
+
+    bool parse_class(std::string_view pattern, std::size_t& i) {
+        std::size_t pos = i + 1;
+        const bool negate = pos < pattern.size() && (pattern[pos] == '!' || pattern[pos] == '^');
+        if (negate) {
+            ++pos;
+        }
+
+        std::bitset<256> members;
+        const std::size_t first = pos;
+        for (; pos < pattern.size() && (pattern[pos] != ']' || pos == first); ++pos) {
+            const auto low = static_cast<unsigned char>(pattern[pos]);
+            if (pos + 2 < pattern.size() && pattern[pos + 1] == '-' && pattern[pos + 2] != ']') {
+                const auto high = static_cast<unsigned char>(pattern[pos + 2]);
+                for (unsigned c = low; c <= high; ++c) {
+                    members.set(c);
+                }
+                pos += 2;
+            } else {
+                members.set(low);
+            }
+        }
+        if (pos >= pattern.size()) {
+            return false; // no closing ']', treat '[' literally
+        }
+
+        classes_.push_back(negate ? ~members : members);
+        add_atom({atom::CLASS, 0, classes_.size() - 1});
+        i = pos;
+        return true;
+    }
+
+    bool match_at(const segment& s, std::string_view str, std::size_t pos) const {
+        for (std::size_t i = 0; i < s.atoms.size(); ++i) {
+            const atom& a = s.atoms[i];
+            const char c = str[pos + i];
+            if ((a.kind == atom::LITERAL && a.c != c)
+                || (a.kind == atom::CLASS && !classes_[a.class_index].test(static_cast<unsigned char>(c)))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void build_shift_masks(segment& s) const {
+        s.words = (s.atoms.size() + 63) / 64;
+        s.shift_masks.assign(256 * s.words, 0);
+        for (std::size_t i = 0; i < s.atoms.size(); ++i) {
+            const atom& a = s.atoms[i];
+            const std::uint64_t bit = std::uint64_t{1} << (i % 64);
+            for (unsigned c = 0; c < 256; ++c) {
+                if (a.kind == atom::ANY || (a.kind == atom::LITERAL && static_cast<unsigned char>(a.c) == c)
+                    || (a.kind == atom::CLASS && classes_[a.class_index].test(c))) {
+                    s.shift_masks[c * s.words + i / 64] |= bit;
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Returns the leftmost position at or after pos where segment s matches inside str.
+     *        State bit j is set while the last j + 1 bytes matched the first j + 1 atoms, so every
+     *        byte is examined once.
+     */
+    std::size_t find_segment(const segment& s, std::string_view str, std::size_t pos) const {
+        const std::size_t m = s.atoms.size();
+        if (m == 0) {
+            return pos;
+        }
+        const bool literal_first = s.atoms.front().kind == atom::LITERAL;
+        const std::uint64_t last_bit = std::uint64_t{1} << ((m - 1) % 64);
+        std::uint64_t single_state = 0;
+        std::vector<std::uint64_t> states(s.words > 1 ? s.words : 0);
+        std::uint64_t* state = s.words > 1 ? states.data() : &single_state;
+        bool pending = false;
+        for (std::size_t i = pos; i < str.size(); ++i) {
+            if (!pending && literal_first) {
+                const void* next = std::memchr(str.data() + i, s.atoms.front().c, str.size() - i);
+                if (next == nullptr) {
+                    return std::string_view::npos;
+                }
+                i = static_cast<std::size_t>(static_cast<const char*>(next) - str.data());
+            }
+            const std::uint64_t* masks = s.shift_masks.data() + static_cast<unsigned char>(str[i]) * s.words;
+            pending = false;
+            for (std::size_t w = s.words; w-- > 0;) {
+                const std::uint64_t carry = w == 0 ? 1 : state[w - 1] >> 63;
+                state[w] = ((state[w] << 1) | carry) & masks[w];
+                pending |= state[w] != 0;
+            }
+            if (state[s.words - 1] & last_bit) {
+                return i + 1 - m;
+            }
+        }
+        return std::string_view::npos;
+    }
+
+    std::string pattern_;
+    std::vector<segment> segments_;
+    std::vector<std::bitset<256>> classes_;
+};
+
+/**
+ * @brief Checks if the whole str matches the wildcard pattern, see strutil::glob_pattern.
+ *        Compile a strutil::glob_pattern instead when matching the same pattern repeatedly.
+ * @param str - input string.
+ * @param pattern - the wildcard pattern.
+ * @return True if str matches pattern.
+ */
+inline bool glob_match(std::string_view str, std::string_view pattern) {
+    return glob_pattern(pattern).matches(str);
+}
+
+/**
+ * @brief A set of strutil::glob_pattern matched together against one input. Patterns are indexed by
+ *        their literal prefix in a byte trie, so only patterns whose prefix the input starts with are tried.
+ */
+class glob_set {
+public:
+    glob_set() : nodes_(1) {}
+
+    /**
+     * @brief Adds a pattern to the set.
+     * @param pattern - the wildcard pattern.
+     * @return Index of the pattern, as reported by matching().
+     */
+    std::size_t add(std::string_view pattern) {
+        patterns_.emplace_back(pattern);
+        std::size_t current = 0;
+        for (char c : patterns_.back().literal_prefix()) {
+            current = child(current, c);
+        }
+        nodes_[current].patterns.push_back(patterns_.size() - 1);
+        return patterns_.size() - 1;
+    }
+
+    /**
+     * @brief Checks if str matches at least one pattern of the set.
+     */
+    bool matches_any(std::string_view str) const {
+        bool found = false;
+        for_each_candidate(str, [&](std::size_t index) {
+            found = patterns_[index].matches(str);
+            return !found;
+        });
+        return found;
+    }
+
+    /**
+     * @brief Returns the indices of all patterns matching str, in ascending order.
+     */
+    std::vector<std::size_t> matching(std::string_view str) const {
+        std::vector<std::size_t> result;
+        for_each_candidate(str, [&](std::size_t index) {
+            if (patterns_[index].matches(str)) {
+                result.push_back(index);
+            }
+            return true;
+        });
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    /**
+     * @brief Returns the number of patterns in the set.
+     */
+    std::size_t size() const {
+        return patterns_.size();
+    }
+
+private:
+    struct node {
+        std::vector<std::pair<char, std::size_t>> children; // sorted by character
+        std::vector<std::size_t> patterns;
+    };
+
+    std::size_t child(std::size_t parent, char c) {
+        auto& children = nodes_[parent].children;
+        auto it = std::lower_bound(children.begin(), children.end(), std::make_pair(c, std::size_t{0}));
+        if (it != children.end() && it->first == c) {
+            return it->second;
+        }
+        const std::size_t index = nodes_.size();
+        children.insert(it, {c, index});
+        nodes_.emplace_back();
+        return index;
+    }
+
+    template<typename OnCandidate>
+    void for_each_candidate(std::string_view str, OnCandidate&& on_candidate) const {
+        std::size_t current = 0;
+        for (std::size_t depth = 0;; ++depth) {
+            for (std::size_t index : nodes_[current].patterns) {
+                if (!on_candidate(index)) {
+                    return;
+                }
+            }
+            if (depth == str.size()) {
+                return;
+            }
+            const auto& children = nodes_[current].children;
+            const auto it = std::lower_bound(children.begin(), children.end(), std::make_pair(str[depth], std::size_t{0}));
+            if (it == children.end() || it->first != str[depth]) {
+                return;
+            }
+            current = it->second;
+        }
+    }
+
+    std::vector<glob_pattern> patterns_;
+    std::vector<node> nodes_;
+};
+
+} // namespace strutil
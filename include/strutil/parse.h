@@ -0,0 +1,647 @@
+/**
+******************************************************************************
+*
+*  @file       strutil/parse.h
+*  @brief      CSV records, key-value pairs and numeric lists
+*
+******************************************************************************
+*/
+
+#pragma once
+
+#include "core.h"
+#include "dispatch.h"
+#include "hash.h"
+#include "split.h"
+#include "trim.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace strutil {
+namespace detail {
+/**
+ * @brief Computes the prefix XOR of mask: bit i of the result is the XOR of bits 0..i of mask.
+ *        Applied to a mask of quote positions it yields the positions inside quoted regions.
+ */
+inline std::uint64_t prefix_xor(std::uint64_t mask) {
+    mask ^= mask << 1;
+    mask ^= mask << 2;
+    mask ^= mask << 4;
+    mask ^= mask << 8;
+    mask ^= mask << 16;
+    mask ^= mask << 32;
+    return mask;
+}
+
+/**
+ * @brief Bit masks of a 64-byte block of CSV text: bit i is set if byte i is a quote, respectively
+ *        a delimiter or '\n'.
+ */
+struct csv_block_masks {
+    std::uint64_t quotes;
+    std::uint64_t structural;
+};
+
+/**
+ * @brief Computes the csv_block_masks of a block one byte at a time.
+ * @param block - pointer to 64 readable bytes.
+ * @param quote - the quote character.
+ * @param delimiter - the field delimiter.
+ */
+inline csv_block_masks csv_masks_scalar(const char* block, char quote, char delimiter) {
+    csv_block_masks masks{0, 0};
+    for (unsigned i = 0; i < 64; ++i) {
+        masks.quotes |= static_cast<std::uint64_t>(block[i] == quote) << i;
+        masks.structural |= static_cast<std::uint64_t>(block[i] == delimiter || block[i] == '\n') << i;
+    }
+    return masks;
+}
+
+#if defined(__SSE2__)
+/**
+ * @brief Computes the csv_block_masks of a block 16 bytes at a time.
+ */
+inline csv_block_masks csv_masks_sse2(const char* block, char quote, char delimiter) {
+    const __m128i quotes = _mm_set1_epi8(quote);
+    const __m128i delimiters = _mm_set1_epi8(delimiter);
+    const __m128i newlines = _mm_set1_epi8('\n');
+    csv_block_masks masks{0, 0};
+    for (unsigned i = 0; i < 4; ++i) {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i * 16));
+        const __m128i structural = _mm_or_si128(_mm_cmpeq_epi8(bytes, delimiters), _mm_cmpeq_epi8(bytes, newlines));
+        masks.quotes |= static_cast<std::uint64_t>(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, quotes)))) << (i * 16);
+        masks.structural |= static_cast<std::uint64_t>(static_cast<unsigned>(_mm_movemask_epi8(structural))) << (i * 16);
+    }
+    return masks;
+}
+#endif
+
+#if defined(STRUTIL_X86_RUNTIME_DISPATCH)
+/**
+ * @brief Computes the csv_block_masks of a block 32 bytes at a time.
+ */
+__attribute__((target("avx2"))) inline csv_block_masks csv_masks_avx2(const char* block, char quote, char delimiter) {
+    const __m256i quotes = _mm256_set1_epi8(quote);
+    const __m256i delimiters = _mm256_set1_epi8(delimiter);
+    const __m256i newlines = _mm256_set1_epi8('\n');
+    csv_block_masks masks{0, 0};
+    for (unsigned i = 0; i < 2; ++i) {
+        const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + i * 32));
+        const __m256i structural = _mm256_or_si256(_mm256_cmpeq_epi8(bytes, delimiters), _mm256_cmpeq_epi8(bytes, newlines));
+        masks.quotes |= static_cast<std::uint64_t>(static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, quotes)))) << (i * 32);
+        masks.structural |= static_cast<std::uint64_t>(static_cast<unsigned>(_mm256_movemask_epi8(structural))) << (i * 32);
+    }
+    return masks;
+}
+#endif
+
+using csv_masks_fn = csv_block_masks (*)(const char*, char, char);
+
+inline constexpr kernel_family<csv_masks_fn> CSV_MASK_KERNELS{
+    "csv_reader", {&csv_masks_scalar, STRUTIL_SSE2_KERNEL(&csv_masks_sse2), STRUTIL_AVX2_KERNEL(&csv_masks_avx2), nullptr}};
+inline const bool CSV_MASK_KERNELS_REGISTERED = register_kernel(CSV_MASK_KERNELS);
+} // namespace detail
+
+/**
+ * @brief RFC 4180 CSV reader. Parses one record at a time from a whole buffer or from a std::istream,
+ *        supporting quoted fields, escaped quotes ("") and newlines inside quoted fields.
+ *        Records may end with "\n" or "\r\n".
+ *
+ *        Fields are returned as std::string_view pointing into the input (or the internal stream buffer);
+ *        only quoted fields containing escaped quotes are unescaped into an internal scratch buffer.
+ *        The views stay valid until the next call to next_record.
+ *
+ *        Quote, delimiter and newline bytes are located 64 bytes at a time: a prefix XOR over the
+ *        quote mask marks the quoted regions, leaving only the structural delimiters and newlines.
+ */
+class csv_reader {
+public:
+    /**
+     * @brief Reads records from a buffer that outlives the reader.
+     * @param input - the whole CSV text.
+     * @param delimiter - field delimiter.
+     * @param quote - quote character.
+     */
+    explicit csv_reader(std::string_view input, char delimiter = ',', char quote = '"')
+        : input_(input), delimiter_(delimiter), quote_(quote) {}
+
+    /**
+     * @brief Reads records from a stream, buffering as much as the longest record needs.
+     * @param source - the stream to read CSV text from.
+     * @param delimiter - field delimiter.
+     * @param quote - quote character.
+     */
+    explicit csv_reader(std::istream& source, char delimiter = ',', char quote = '"')
+        : source_(&source), delimiter_(delimiter), quote_(quote) {}
+
+    /**
+     * @brief Parses the next record.
+     * @param fields - receives the fields of the record; previous contents are discarded.
+     * @return True if a record was read, false at the end of the input.
+     */
+    bool next_record(std::vector<std::string_view>& fields) {
+        fields.clear();
+        while (true) {
+            if (position_ >= data().size() && !refill()) {
+                return false;
+            }
+            if (parse_record()) {
+                break;
+            }
+            // the record continues past the buffered data, read more and parse it again
+            if (!refill()) {
+                parse_record(true);
+                break;
+            }
+        }
+
+        for (const auto& span : spans_) {
+            const char* base = span.in_scratch ? scratch_.data() : data().data();
+            fields.emplace_back(base + span.offset, span.size);
+        }
+        return true;
+    }
+
+private:
+    struct field_span {
+        bool in_scratch;
+        std::size_t offset;
+        std::size_t size;
+    };
+
+    std::string_view data() const {
+        return source_ != nullptr ? std::string_view(buffer_) : input_;
+    }
+
+    /**
+     * @brief Appends more of the stream to the buffer, dropping the already consumed records.
+     * @return False if there is no more input.
+     */
+    bool refill() {
+        if (source_ == nullptr || !*source_) {
+            return false;
+        }
+        buffer_.erase(0, position_);
+        position_ = 0;
+
+        // grow geometrically so very long records are not rescanned too often
+        const std::size_t chunk = std::max<std::size_t>(64 * 1024, buffer_.size());
+        const std::size_t old_size = buffer_.size();
+        buffer_.resize(old_size + chunk);
+        source_->read(&buffer_[old_size], static_cast<std::streamsize>(chunk));
+        buffer_.resize(old_size + static_cast<std::size_t>(source_->gcount()));
+        return buffer_.size() > old_size;
+    }
+
+    /**
+     * @brief Parses the record starting at position_ into spans_.
+     * @param at_end - true if no more input will follow the buffered data.
+     * @return False if the record is incomplete and more input is needed.
+     */
+    bool parse_record(bool at_end = false) {
+        const std::string_view text = data();
+        spans_.clear();
+        scratch_.clear();
+
+        const detail::csv_masks_fn block_masks = detail::CSV_MASK_KERNELS.get();
+        std::size_t field_start = position_;
+        std::uint64_t inside_quotes = 0; // all ones while the previous block ended inside quotes
+        char padded[64];
+        for (std::size_t block = position_; block < text.size(); block += 64) {
+            const char* bytes = text.data() + block;
+            if (text.size() - block < 64) {
+                // only the final partial block is copied and zero-filled
+                const std::size_t tail = text.size() - block;
+                std::memcpy(padded, bytes, tail);
+                std::memset(padded + tail, 0, 64 - tail);
+                bytes = padded;
+            }
+
+            const detail::csv_block_masks masks = block_masks(bytes, quote_, delimiter_);
+            const std::uint64_t quoted = detail::prefix_xor(masks.quotes) ^ inside_quotes;
+            inside_quotes = static_cast<std::uint64_t>(0) - (quoted >> 63);
+            std::uint64_t structural = masks.structural & ~quoted;
+            if (bytes == padded) {
+                structural &= (std::uint64_t{1} << (text.size() - block)) - 1;
+            }
+
+            for (; structural != 0; structural &= structural - 1) {
+                const std::size_t pos = block + detail::count_trailing_zeros(structural);
+                if (text[pos] == delimiter_) {
+                    add_field(text, field_start, pos);
+                    field_start = pos + 1;
+                } else {
+                    const bool crlf = pos > field_start && text[pos - 1] == '\r';
+                    add_field(text, field_start, crlf ? pos - 1 : pos);
+                    position_ = pos + 1;
+                    return true;
+                }
+            }
+        }
+
+        if (!at_end && source_ != nullptr) {
+            return false;
+        }
+        // last record without a trailing newline; a final '\r' is dropped like the one of a CRLF
+        std::size_t end = text.size();
+        if (inside_quotes == 0 && end > field_start && text[end - 1] == '\r') {
+            --end;
+        }
+        add_field(text, field_start, end);
+        position_ = text.size();
+        return true;
+    }
+
+    /**
+     * @brief Records the field text[begin, end), stripping quotes and unescaping "" if needed.
+     */
+    void add_field(std::string_view text, std::size_t begin, std::size_t end) {
+        if (begin == end || text[begin] != quote_) {
+            spans_.push_back({false, begin, end - begin});
+            return;
+        }
+
+        // quoted field: drop the surrounding quotes
+        ++begin;
+        if (end > begin && text[end - 1] == quote_) {
+            --end;
+        }
+        const std::string_view content = text.substr(begin, end - begin);
+        if (content.find(quote_) == std::string_view::npos) {
+            spans_.push_back({false, begin, end - begin});
+            return;
+        }
+
+        const std::size_t offset = scratch_.size();
+        for (std::size_t i = 0; i < content.size(); ++i) {
+            scratch_.push_back(content[i]);
+            if (content[i] == quote_ && i + 1 < content.size() && content[i + 1] == quote_) {
+                ++i;
+            }
+        }
+        spans_.push_back({true, offset, scratch_.size() - offset});
+    }
+
+    std::string_view input_;
+    std::istream* source_ = nullptr;
+    std::string buffer_;
+    std::size_t position_ = 0;
+    char delimiter_;
+    char quote_;
+    std::vector<field_span> spans_;
+    std::string scratch_;
+};
+
+/**
+ * @brief A key/value pair of views produced by strutil::parse_kv and strutil::parse_query.
+ */
+using kv_pair = std::pair<std::string_view, std::string_view>;
+
+namespace detail {
+/**
+ * @brief Appends str to out with %XX sequences decoded and, optionally, '+' turned into a space.
+ *        Malformed % sequences are copied literally.
+ * @param out - string receiving the decoded bytes.
+ * @param str - percent-encoded input.
+ * @param plus_as_space - decode '+' as ' ' (application/x-www-form-urlencoded).
+ */
+inline void append_percent_decoded(std::string& out, std::string_view str, bool plus_as_space) {
+    for (std::size_t i = 0; i < str.size(); ++i) {
+        if (str[i] == '%' && i + 2 < str.size() && hex_digit_value(str[i + 1]) >= 0 && hex_digit_value(str[i + 2]) >= 0) {
+            out.push_back(static_cast<char>(hex_digit_value(str[i + 1]) * 16 + hex_digit_value(str[i + 2])));
+            i += 2;
+        } else if (str[i] == '+' && plus_as_space) {
+            out.push_back(' ');
+        } else {
+            out.push_back(str[i]);
+        }
+    }
+}
+
+/**
+ * @brief Calls on_pair for every non-empty pair of str.
+ * @param str - string of pairs such as "k1=v1;k2=v2".
+ * @param pair_delim - delimiter between pairs.
+ * @param kv_delim - delimiter between a key and its value; a pair without it has an empty value.
+ * @param trim - trim whitespace around keys and values.
+ * @param on_pair - callable invoked with the key and the value.
+ */
+template<typename OnPair>
+void parse_kv_each(std::string_view str, char pair_delim, char kv_delim, bool trim, OnPair&& on_pair) {
+    split_each(str, pair_delim, [&](std::string_view pair) {
+        if (trim) {
+            pair = trim_view(pair);
+        }
+        if (pair.empty()) {
+            return;
+        }
+        const std::size_t split_pos = pair.find(kv_delim);
+        std::string_view key = pair.substr(0, split_pos);
+        std::string_view value = split_pos == std::string_view::npos ? std::string_view() : pair.substr(split_pos + 1);
+        if (trim) {
+            key = trim_view(key);
+            value = trim_view(value);
+        }
+        on_pair(key, value);
+    });
+}
+} // namespace detail
+
+/**
+ * @brief Decodes %XX escape sequences, e.g. of a URL component.
+ * @param str - percent-encoded input. Malformed % sequences are copied literally.
+ * @param plus_as_space - decode '+' as ' ', as used by HTML form encoding.
+ * @return Decoded string.
+ */
+inline std::string percent_decode(std::string_view str, bool plus_as_space = false) {
+    std::string result;
+    result.reserve(str.size());
+    detail::append_percent_decoded(result, str, plus_as_space);
+    return result;
+}
+
+/**
+ * @brief Parses a string of key/value pairs such as "k1=v1;k2=v2" without copying.
+ *        Empty pairs are skipped, a pair without kv_delim gets an empty value.
+ * @param str - string to parse; the returned views point into it.
+ * @param pair_delim - delimiter between pairs.
+ * @param kv_delim - delimiter between a key and its value.
+ * @param trim - trim whitespace around keys and values with strutil::trim_view.
+ * @return Pairs of views in input order.
+ */
+inline std::vector<kv_pair> parse_kv(std::string_view str, char pair_delim = ';', char kv_delim = '=', bool trim = false) {
+    std::vector<kv_pair> pairs;
+    detail::parse_kv_each(str, pair_delim, kv_delim, trim, [&](std::string_view key, std::string_view value) {
+        pairs.emplace_back(key, value);
+    });
+    return pairs;
+}
+
+/**
+ * @brief Same as strutil::parse_kv but writes into out, reusing its capacity.
+ * @param str - string to parse; the views stored in out point into it.
+ * @param out - receives the pairs; previous contents are discarded.
+ * @param pair_delim - delimiter between pairs.
+ * @param kv_delim - delimiter between a key and its value.
+ * @param trim - trim whitespace around keys and values with strutil::trim_view.
+ */
+inline void parse_kv_into(std::string_view str,
+                          std::vector<kv_pair>& out,
+                          char pair_delim = ';',
+                          char kv_delim = '=',
+                          bool trim = false) {
+    out.clear();
+    detail::parse_kv_each(str, pair_delim, kv_delim, trim, [&](std::string_view key, std::string_view value) {
+        out.emplace_back(key, value);
+    });
+}
+
+/**
+ * @brief Parses a URL query string such as "a=1&b=hello+world%21" with percent-decoding.
+ *        Keys and values without escapes point into str, the others are decoded into scratch.
+ * @param str - query string without the leading '?'.
+ * @param scratch - buffer holding decoded keys and values; must outlive the result and not be modified meanwhile.
+ * @param plus_as_space - decode '+' as ' ', as used by HTML form encoding.
+ * @return Pairs of views in input order.
+ */
+inline std::vector<kv_pair> parse_query(std::string_view str, std::string& scratch, bool plus_as_space = true) {
+    // decoding never grows the text, so views into scratch stay valid while it is filled
+    scratch.clear();
+    scratch.reserve(str.size());
+
+    const auto decode = [&](std::string_view part) {
+        if (part.find('%') == std::string_view::npos && (!plus_as_space || part.find('+') == std::string_view::npos)) {
+            return part;
+        }
+        const std::size_t offset = scratch.size();
+        detail::append_percent_decoded(scratch, part, plus_as_space);
+        return std::string_view(scratch.data() + offset, scratch.size() - offset);
+    };
+
+    std::vector<kv_pair> pairs;
+    detail::parse_kv_each(str, '&', '=', false, [&](std::string_view key, std::string_view value) {
+        pairs.emplace_back(decode(key), decode(value));
+    });
+    return pairs;
+}
+
+/**
+ * @brief Read-only index over parsed key/value pairs with O(1) average lookup by key.
+ *        Uses an open-addressing (linear probing) table of pair indices at most half full.
+ *        For duplicate keys, the first occurrence wins.
+ */
+class kv_index {
+public:
+    /**
+     * @brief Builds the index.
+     * @param pairs - pairs returned by strutil::parse_kv or strutil::parse_query.
+     */
+    explicit kv_index(std::vector<kv_pair> pairs) : pairs_(std::move(pairs)) {
+        std::size_t capacity = 8;
+        while (capacity < pairs_.size() * 2) {
+            capacity *= 2;
+        }
+        slots_.assign(capacity, EMPTY);
+
+        for (std::size_t i = 0; i < pairs_.size(); ++i) {
+            std::size_t slot = find_slot(pairs_[i].first);
+            if (slots_[slot] == EMPTY) {
+                slots_[slot] = static_cast<std::uint32_t>(i);
+            }
+        }
+    }
+
+    /**
+     * @brief Looks up the value of key.
+     * @param key - the key to look for.
+     * @return Pointer to the value, or nullptr if key is not present.
+     */
+    const std::string_view* find(std::string_view key) const {
+        const std::uint32_t index = slots_[find_slot(key)];
+        return index == EMPTY ? nullptr : &pairs_[index].second;
+    }
+
+    /**
+     * @brief Checks if key is present.
+     */
+    bool contains(std::string_view key) const {
+        return find(key) != nullptr;
+    }
+
+    /**
+     * @brief Returns the value of key, or fallback if key is not present.
+     */
+    std::string_view get(std::string_view key, std::string_view fallback = {}) const {
+        const std::string_view* value = find(key);
+        return value != nullptr ? *value : fallback;
+    }
+
+    /**
+     * @brief Returns all indexed pairs in input order.
+     */
+    const std::vector<kv_pair>& pairs() const {
+        return pairs_;
+    }
+
+private:
+    static constexpr std::uint32_t EMPTY = 0xFFFFFFFFu;
+
+    std::size_t find_slot(std::string_view key) const {
+        const std::size_t mask = slots_.size() - 1;
+        std::size_t slot = static_cast<std::size_t>(strutil::hash(key)) & mask;
+        while (slots_[slot] != EMPTY && pairs_[slots_[slot]].first != key) {
+            slot = (slot + 1) & mask;
+        }
+        return slot;
+    }
+
+    std::vector<kv_pair> pairs_;
+    std::vector<std::uint32_t> slots_;
+};
+
+namespace detail {
+/**
+ * @brief Parses exactly eight ASCII decimal digits with a few 64-bit operations (SWAR).
+ * @param digits - pointer to eight readable bytes.
+ * @param value - receives the parsed value.
+ * @return False if any of the bytes is not a decimal digit.
+ */
+inline bool parse_eight_digits(const char* digits, std::uint64_t& value) {
+    std::uint64_t chunk;
+    std::memcpy(&chunk, digits, sizeof(chunk));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    chunk = __builtin_bswap64(chunk);
+#endif
+    // every byte must be 0x30..0x39: high nibble 3, low nibble not above 9
+    if ((chunk & 0xF0F0F0F0F0F0F0F0ull) != 0x3030303030303030ull
+        || ((chunk + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) != 0x3030303030303030ull) {
+        return false;
+    }
+    chunk = ((chunk & 0x0F0F0F0F0F0F0F0Full) * 2561) >> 8;
+    chunk = ((chunk & 0x00FF00FF00FF00FFull) * 6553601) >> 16;
+    value = ((chunk & 0x0000FFFF0000FFFFull) * 42949672960001ull) >> 32;
+    return true;
+}
+
+/**
+ * @brief Parses a whole field as a number of type T.
+ *        Integers of up to 16 digits are parsed eight digits at a time, everything else uses std::from_chars.
+ * @param field - text of the field, without surrounding whitespace.
+ * @param value - receives the parsed value.
+ * @return True if the whole field is a valid number in the range of T.
+ */
+template<typename T>
+bool parse_number(std::string_view field, T& value) {
+    if constexpr (std::is_integral_v<T>) {
+        std::string_view digits = field;
+        bool negative = false;
+        if (std::is_signed_v<T> && !digits.empty() && digits.front() == '-') {
+            negative = true;
+            digits.remove_prefix(1);
+        }
+
+        if (!digits.empty() && digits.size() <= 16) {
+            std::uint64_t magnitude = 0;
+            std::size_t i = 0;
+            for (std::uint64_t chunk; i + 8 <= digits.size(); i += 8) {
+                if (!parse_eight_digits(digits.data() + i, chunk)) {
+                    return false;
+                }
+                magnitude = magnitude * 100000000 + chunk;
+            }
+            for (; i < digits.size(); ++i) {
+                const auto digit = static_cast<unsigned>(digits[i] - '0');
+                if (digit > 9) {
+                    return false;
+                }
+                magnitude = magnitude * 10 + digit;
+            }
+
+            // at most 16 digits, so the magnitude fits in int64_t
+            const auto signed_value = negative ? -static_cast<std::int64_t>(magnitude) : static_cast<std::int64_t>(magnitude);
+            if constexpr (std::is_signed_v<T>) {
+                if (signed_value < static_cast<std::int64_t>(std::numeric_limits<T>::min())
+                    || signed_value > static_cast<std::int64_t>(std::numeric_limits<T>::max())) {
+                    return false;
+                }
+            } else if (magnitude > static_cast<std::uint64_t>(std::numeric_limits<T>::max())) {
+                return false;
+            }
+            value = static_cast<T>(signed_value);
+            return true;
+        }
+    }
+
+    const char* end = field.data() + field.size();
+    const auto result = std::from_chars(field.data(), end, value);
+    return result.ec == std::errc() && result.ptr == end;
+}
+} // namespace detail
+
+/**
+ * @brief Parses a delimited list of numbers such as "1,2,3" in a single pass without allocating tokens.
+ *        Fields may be surrounded by whitespace; an empty input yields no numbers.
+ * @tparam T - integral or floating point type, parsed as by std::from_chars.
+ * @param str - the delimited numbers.
+ * @param delim - the delimiter.
+ * @param out - receives the numbers; previous contents are discarded. On error, holds the numbers before the bad field.
+ * @return std::string_view::npos on success, otherwise the offset of the first malformed or out-of-range field.
+ */
+template<typename T>
+std::size_t parse_numbers_into(std::string_view str, const char delim, std::vector<T>& out) {
+    static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, "parse_numbers_into requires a numeric type");
+
+    out.clear();
+    if (trim_view(str).empty()) {
+        return std::string_view::npos;
+    }
+
+    std::size_t start = 0;
+    while (true) {
+        const std::size_t pos = str.find(delim, start);
+        const std::size_t end = pos == std::string_view::npos ? str.size() : pos;
+
+        T value;
+        if (!detail::parse_number(trim_view(str.substr(start, end - start)), value)) {
+            return start;
+        }
+        out.push_back(value);
+
+        if (pos == std::string_view::npos) {
+            return std::string_view::npos;
+        }
+        start = pos + 1;
+    }
+}
+
+/**
+ * @brief Parses a delimited list of numbers such as "1,2,3" into a std::vector<T>.
+ * @tparam T - integral or floating point type, parsed as by std::from_chars.
+ * @param str - the delimited numbers.
+ * @param delim - the delimiter.
+ * @param error_offset - if not null, receives std::string_view::npos on success or the offset of the first malformed field.
+ * @return The numbers, up to the first malformed field.
+ */
+template<typename T>
+std::vector<T> split_numbers(std::string_view str, const char delim, std::size_t* error_offset = nullptr) {
+    std::vector<T> numbers;
+    numbers.reserve(1u + static_cast<std::size_t>(std::count(str.begin(), str.end(), delim)));
+    const std::size_t offset = parse_numbers_into(str, delim, numbers);
+    if (error_offset != nullptr) {
+        *error_offset = offset;
+    }
+    return numbers;
+}
+
+} // namespace strutil
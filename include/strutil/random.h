@@ -0,0 +1,46 @@
+/**
+******************************************************************************
+*
+*  @file       strutil/random.h
+*  @brief      Random string generation
+*
+******************************************************************************
+*/
+
+#pragma once
+
+#include "core.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+#include <string>
+
+namespace strutil {
+/**
+ * @brief Generate string of given size consisting of random alphanumeric characters
+ * @param size - number of chars in string
+ */
+inline std::string random_alphanumeric_string(size_t size) {
+    static const char symbols[] =
+        "0123456789"
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+        "abcdefghijklmnopqrstuvwxyz";
+    std::string result;
+    result.reserve(size);
+    std::generate_n(std::back_inserter(result), size, []() { return symbols[rand() % (sizeof(symbols) - 1)]; });
+    return result;
+}
+
+/**
+ * @brief generates string of random lowercase latin characters
+ * @param size - number of chars in string
+ */
+inline std::string random_lowercase_string(size_t size) {
+    std::string result;
+    result.reserve(size);
+    std::generate_n(std::back_inserter(result), size, []() { return 'a' + char(rand() % ('z' - 'a')); });
+    return result;
+}
+
+} // namespace strutil
@@ -0,0 +1,479 @@
+/**
+******************************************************************************
+*
+*  @file       strutil/sort.h
+*  @brief      Sorting and reversing string vectors
+*
+******************************************************************************
+*/
+
+#pragma once
+
+#include "core.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace strutil {
+namespace detail {
+/**
+ * @brief Sort record of one string: up to 8 bytes of the string starting at the current depth, packed
+ *        big-endian so that comparing keys as integers compares those bytes, plus the string's index.
+ *        tail is the number of bytes left from the depth, capped at 9; it orders a string before its
+ *        extensions ("ab" < "ab\0") and a tail of 9 marks strings that need a deeper key to break ties.
+ */
+struct string_sort_entry {
+    std::uint64_t key;
+    std::uint32_t tail;
+    std::uint32_t index;
+};
+
+/**
+ * @brief True for the string types whose operator< is a plain unsigned byte comparison,
+ *        which the radix sort reproduces.
+ */
+template<typename T>
+struct is_byte_string : std::false_type {};
+
+template<typename Allocator>
+struct is_byte_string<std::basic_string<char, std::char_traits<char>, Allocator>> : std::true_type {};
+
+template<>
+struct is_byte_string<std::string_view> : std::true_type {};
+
+/**
+ * @brief Inputs smaller than this are sorted with std::sort directly.
+ */
+inline constexpr std::size_t RADIX_SORT_MIN_SIZE = 64;
+
+inline bool entry_less(const string_sort_entry& lhs, const string_sort_entry& rhs) {
+    return lhs.key != rhs.key ? lhs.key < rhs.key : lhs.tail < rhs.tail;
+}
+
+/**
+ * @brief Loads the key of str at byte offset depth (depth <= str.size()) into entry.
+ */
+inline void load_sort_key(string_sort_entry& entry, std::string_view str, std::size_t depth) {
+    const std::size_t remaining = str.size() - depth;
+    const std::size_t count = std::min<std::size_t>(remaining, 8);
+    unsigned char bytes[8] = {};
+    if (count != 0) {
+        std::memcpy(bytes, str.data() + depth, count);
+    }
+    std::uint64_t key = 0;
+    for (unsigned char byte : bytes) {
+        key = (key << 8) | byte;
+    }
+    entry.key = key;
+    entry.tail = static_cast<std::uint32_t>(std::min<std::size_t>(remaining, 9));
+}
+
+/**
+ * @brief Multikey sort with 8-byte characters: sorts [first, last) by cached keys, then re-keys every
+ *        run of equal keys 8 bytes deeper and sorts the run again, until all ties are real duplicates.
+ * @param first, last - entries whose keys were loaded at depth.
+ * @param views - the strings the entries index into.
+ * @param depth - byte offset the keys were loaded at.
+ */
+inline void sort_entries(string_sort_entry* first, string_sort_entry* last, const std::string_view* views, std::size_t depth) {
+    struct range {
+        string_sort_entry* first;
+        string_sort_entry* last;
+        std::size_t depth;
+    };
+    std::vector<range> pending{{first, last, depth}};
+    while (!pending.empty()) {
+        const range current = pending.back();
+        pending.pop_back();
+        std::sort(current.first, current.last, entry_less);
+
+        for (string_sort_entry* run = current.first; run != current.last;) {
+            string_sort_entry* run_end = run + 1;
+            while (run_end != current.last && run_end->key == run->key && run_end->tail == run->tail) {
+                ++run_end;
+            }
+            if (run->tail > 8 && run_end - run > 1) {
+                for (string_sort_entry* entry = run; entry != run_end; ++entry) {
+                    load_sort_key(*entry, views[entry->index], current.depth + 8);
+                }
+                pending.push_back({run, run_end, current.depth + 8});
+            }
+            run = run_end;
+        }
+    }
+}
+
+/**
+ * @brief MSD radix pass on the first key byte, then sort_entries on each of the 256 buckets.
+ * @param first, last - entries whose keys were loaded at depth 0.
+ * @param views - the strings the entries index into.
+ */
+inline void radix_sort_entries(string_sort_entry* first, string_sort_entry* last, const std::string_view* views) {
+    std::size_t offsets[257] = {};
+    for (const string_sort_entry* entry = first; entry != last; ++entry) {
+        ++offsets[(entry->key >> 56) + 1];
+    }
+    for (std::size_t i = 1; i < 257; ++i) {
+        offsets[i] += offsets[i - 1];
+    }
+
+    std::vector<string_sort_entry> buffer(static_cast<std::size_t>(last - first));
+    std::size_t next[256];
+    std::copy(offsets, offsets + 256, next);
+    for (const string_sort_entry* entry = first; entry != last; ++entry) {
+        buffer[next[entry->key >> 56]++] = *entry;
+    }
+    std::copy(buffer.begin(), buffer.end(), first);
+
+    for (std::size_t bucket = 0; bucket < 256; ++bucket) {
+        if (offsets[bucket + 1] - offsets[bucket] > 1) {
+            sort_entries(first + offsets[bucket], first + offsets[bucket + 1], views, 0);
+        }
+    }
+}
+
+/**
+ * @brief Orders views and returns the sort entries; entry i holds the index of the i-th smallest string.
+ *        With several threads, each sorts a slice and the sorted slices are merged pairwise in parallel.
+ */
+inline std::vector<string_sort_entry> sort_string_entries(const std::vector<std::string_view>& views, unsigned threads) {
+    const std::size_t size = views.size();
+    std::vector<string_sort_entry> entries(size);
+    threads = std::max(1u, std::min<unsigned>(threads, static_cast<unsigned>(size / RADIX_SORT_MIN_SIZE)));
+    const std::size_t slice = (size + threads - 1) / threads;
+
+    const auto sort_slice = [&](unsigned t) {
+        const std::size_t begin = std::min(size, t * slice);
+        const std::size_t end = std::min(size, begin + slice);
+        for (std::size_t i = begin; i < end; ++i) {
+            entries[i].index = static_cast<std::uint32_t>(i);
+            load_sort_key(entries[i], views[i], 0);
+        }
+        radix_sort_entries(entries.data() + begin, entries.data() + end, views.data());
+    };
+    if (threads == 1) {
+        sort_slice(0);
+        return entries;
+    }
+
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back(sort_slice, t);
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    const auto by_string = [&views](const string_sort_entry& lhs, const string_sort_entry& rhs) {
+        return views[lhs.index] < views[rhs.index];
+    };
+    for (std::size_t width = slice; width < size; width *= 2) {
+        workers.clear();
+        for (std::size_t begin = 0; begin + width < size; begin += 2 * width) {
+            workers.emplace_back([&, begin, width]() {
+                const auto middle = entries.begin() + static_cast<std::ptrdiff_t>(begin + width);
+                const auto end = entries.begin() + static_cast<std::ptrdiff_t>(std::min(size, begin + 2 * width));
+                std::inplace_merge(entries.begin() + static_cast<std::ptrdiff_t>(begin), middle, end, by_string);
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+    return entries;
+}
+
+/**
+ * @brief Sorts strs with radix_sort_entries and moves the elements into their sorted positions.
+ */
+template<typename T>
+void radix_sort_strings(std::vector<T>& strs, bool descending, unsigned threads) {
+    if (strs.size() < RADIX_SORT_MIN_SIZE || strs.size() > std::numeric_limits<std::uint32_t>::max()) {
+        if (descending) {
+            std::sort(strs.begin(), strs.end(), std::greater<T>());
+        } else {
+            std::sort(strs.begin(), strs.end());
+        }
+        return;
+    }
+
+    const std::vector<std::string_view> views(strs.begin(), strs.end());
+    const std::vector<string_sort_entry> entries = sort_string_entries(views, threads);
+
+    std::vector<T> sorted;
+    sorted.reserve(strs.size());
+    if (descending) {
+        for (auto it = entries.rbegin(); it != entries.rend(); ++it) {
+            sorted.push_back(std::move(strs[it->index]));
+        }
+    } else {
+        for (const string_sort_entry& entry : entries) {
+            sorted.push_back(std::move(strs[entry.index]));
+        }
+    }
+    strs.swap(sorted);
+}
+} // namespace detail
+
+/**
+ * @brief Sort input std::vector<std::string> strs in ascending order.
+ *        Vectors of std::string and std::string_view are radix sorted on cached 8-byte key prefixes,
+ *        other element types use std::sort.
+ * @param strs - std::vector<std::string> to be checked.
+ * @param threads - number of threads sorting slices of large string vectors before merging them.
+ */
+template<typename T>
+void sorting_ascending(std::vector<T>& strs, unsigned threads = 1) {
+    if constexpr (detail::is_byte_string<T>::value) {
+        detail::radix_sort_strings(strs, false, threads);
+    } else {
+        std::sort(strs.begin(), strs.end());
+    }
+}
+
+/**
+ * @brief Sorted input std::vector<std::string> strs in descending order.
+ *        Uses the same radix sort as strutil::sorting_ascending for string elements.
+ * @param strs - std::vector<std::string> to be checked.
+ * @param threads - number of threads sorting slices of large string vectors before merging them.
+ */
+template<typename T>
+void sorting_descending(std::vector<T>& strs, unsigned threads = 1) {
+    if constexpr (detail::is_byte_string<T>::value) {
+        detail::radix_sort_strings(strs, true, threads);
+    } else {
+        std::sort(strs.begin(), strs.end(), std::greater<T>());
+    }
+}
+
+/**
+ * @brief Sorts string views in ascending order, e.g. tokens returned by the split functions.
+ *        Only the views are moved; the characters they refer to are not touched.
+ * @param views - views to sort.
+ * @param threads - number of threads sorting slices of large inputs before merging them.
+ */
+inline void sort_views(std::vector<std::string_view>& views, unsigned threads = 1) {
+    detail::radix_sort_strings(views, false, threads);
+}
+
+namespace detail {
+/**
+ * @brief Appends count to key so that a larger count compares greater byte by byte:
+ *        one byte below 255, otherwise 0xFF followed by 8 big-endian bytes.
+ */
+inline void append_ordered_count(std::string& key, std::size_t count) {
+    if (count < 0xFF) {
+        key.push_back(static_cast<char>(count));
+        return;
+    }
+    key.push_back('\xFF');
+    for (int shift = 56; shift >= 0; shift -= 8) {
+        key.push_back(static_cast<char>((static_cast<std::uint64_t>(count) >> shift) & 0xFF));
+    }
+}
+
+/**
+ * @brief Appends the natural sort key of str: bytes outside digit runs are copied, every digit run
+ *        becomes '0', its significant digit count, the significant digits and its leading zero count.
+ *        Comparing two keys byte by byte gives the same result as strutil::natural_compare.
+ */
+inline void append_natural_key(std::string& key, std::string_view str) {
+    for (std::size_t i = 0; i < str.size();) {
+        if (str[i] < '0' || str[i] > '9') {
+            key.push_back(str[i++]);
+            continue;
+        }
+        const std::size_t run_start = i;
+        while (i < str.size() && str[i] == '0') {
+            ++i;
+        }
+        const std::size_t digits_start = i;
+        while (i < str.size() && str[i] >= '0' && str[i] <= '9') {
+            ++i;
+        }
+        key.push_back('0');
+        append_ordered_count(key, i - digits_start);
+        key.append(str.substr(digits_start, i - digits_start));
+        append_ordered_count(key, digits_start - run_start);
+    }
+}
+
+/**
+ * @brief Appends str with ASCII letters lowercased, the sort key of strutil::sort_ignore_case.
+ */
+inline void append_ignore_case_key(std::string& key, std::string_view str) {
+    for (char c : str) {
+        key.push_back(static_cast<char>(ascii_to_lower(static_cast<unsigned char>(c))));
+    }
+}
+
+/**
+ * @brief Schwartzian transform: builds the key of every element once into a contiguous arena,
+ *        radix sorts the keys and moves the elements into key order. Elements with equal keys
+ *        keep their input order.
+ * @param strs - elements to sort.
+ * @param append_key - callable appending the key of a std::string_view to a std::string.
+ * @param threads - number of threads passed to the key sort.
+ */
+template<typename T, typename AppendKey>
+void sort_by_keys(std::vector<T>& strs, AppendKey&& append_key, unsigned threads) {
+    const std::size_t size = strs.size();
+    std::size_t total = 0;
+    for (const T& str : strs) {
+        total += std::string_view(str).size();
+    }
+    std::string arena;
+    arena.reserve(total);
+    std::vector<std::size_t> ends;
+    ends.reserve(size);
+    for (const T& str : strs) {
+        append_key(arena, std::string_view(str));
+        ends.push_back(arena.size());
+    }
+    std::vector<std::string_view> keys;
+    keys.reserve(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        const std::size_t begin = i == 0 ? 0 : ends[i - 1];
+        keys.emplace_back(arena.data() + begin, ends[i] - begin);
+    }
+
+    std::vector<std::size_t> order(size);
+    if (size > std::numeric_limits<std::uint32_t>::max()) {
+        for (std::size_t i = 0; i < size; ++i) {
+            order[i] = i;
+        }
+        std::stable_sort(order.begin(), order.end(), [&keys](std::size_t lhs, std::size_t rhs) { return keys[lhs] < keys[rhs]; });
+    } else {
+        const std::vector<string_sort_entry> entries = sort_string_entries(keys, threads);
+        for (std::size_t i = 0; i < size; ++i) {
+            order[i] = entries[i].index;
+        }
+        for (std::size_t run = 0; run < size;) {
+            std::size_t run_end = run + 1;
+            while (run_end < size && keys[order[run_end]] == keys[order[run]]) {
+                ++run_end;
+            }
+            std::sort(order.begin() + static_cast<std::ptrdiff_t>(run), order.begin() + static_cast<std::ptrdiff_t>(run_end));
+            run = run_end;
+        }
+    }
+
+    std::vector<T> sorted;
+    sorted.reserve(size);
+    for (std::size_t index : order) {
+        sorted.push_back(std::move(strs[index]));
+    }
+    strs.swap(sorted);
+}
+} // namespace detail
+
+/**
+ * @brief Compares two strings in natural order: runs of decimal digits compare by numeric value,
+ *        so "file2" < "file10", everything else compares byte by byte. Equal numbers with more
+ *        leading zeros sort after ("1" < "01").
+ * @param str1 - first string.
+ * @param str2 - second string.
+ * @return Negative if str1 orders before str2, positive if after, 0 if the strings are equal.
+ */
+inline int natural_compare(std::string_view str1, std::string_view str2) {
+    const auto is_digit = [](char c) { return c >= '0' && c <= '9'; };
+    std::size_t i = 0;
+    std::size_t j = 0;
+    while (i < str1.size() && j < str2.size()) {
+        if (!is_digit(str1[i]) || !is_digit(str2[j])) {
+            if (str1[i] != str2[j]) {
+                return static_cast<unsigned char>(str1[i]) < static_cast<unsigned char>(str2[j]) ? -1 : 1;
+            }
+            ++i;
+            ++j;
+            continue;
+        }
+
+        const std::size_t zeros_start1 = i;
+        const std::size_t zeros_start2 = j;
+        while (i < str1.size() && str1[i] == '0') {
+            ++i;
+        }
+        while (j < str2.size() && str2[j] == '0') {
+            ++j;
+        }
+        const std::size_t digits_start1 = i;
+        const std::size_t digits_start2 = j;
+        while (i < str1.size() && is_digit(str1[i])) {
+            ++i;
+        }
+        while (j < str2.size() && is_digit(str2[j])) {
+            ++j;
+        }
+        const std::size_t digits1 = i - digits_start1;
+        const std::size_t digits2 = j - digits_start2;
+        if (digits1 != digits2) {
+            return digits1 < digits2 ? -1 : 1;
+        }
+        const int order = str1.substr(digits_start1, digits1).compare(str2.substr(digits_start2, digits2));
+        if (order != 0) {
+            return order;
+        }
+        const std::size_t zeros1 = digits_start1 - zeros_start1;
+        const std::size_t zeros2 = digits_start2 - zeros_start2;
+        if (zeros1 != zeros2) {
+            return zeros1 < zeros2 ? -1 : 1;
+        }
+    }
+    if (i < str1.size()) {
+        return 1;
+    }
+    return j < str2.size() ? -1 : 0;
+}
+
+/**
+ * @brief Sorts strings in natural order (see strutil::natural_compare). The sort key of every
+ *        element is built once, so digit runs are parsed n times instead of n log n times.
+ * @param strs - std::vector of std::string or std::string_view to sort.
+ * @param threads - number of threads sorting slices of large inputs before merging them.
+ */
+template<typename T>
+void sort_natural(std::vector<T>& strs, unsigned threads = 1) {
+    detail::sort_by_keys(strs, &detail::append_natural_key, threads);
+}
+
+/**
+ * @brief Sorts strings ignoring ASCII case; strings that differ only in case keep their input order.
+ *        The lowercased key of every element is built once.
+ * @param strs - std::vector of std::string or std::string_view to sort.
+ * @param threads - number of threads sorting slices of large inputs before merging them.
+ */
+template<typename T>
+void sort_ignore_case(std::vector<T>& strs, unsigned threads = 1) {
+    detail::sort_by_keys(strs, &detail::append_ignore_case_key, threads);
+}
+
+/**
+ * @brief Reverse input std::vector<std::string> strs.
+ * @param strs - std::vector<std::string> to be checked.
+ */
+template<typename T>
+void reverse_inplace(std::vector<T>& strs) {
+    std::reverse(strs.begin(), strs.end());
+}
+
+/**
+ * @brief Reverse input std::vector<std::string> strs.
+ * @param strs - std::vector<std::string> to be checked.
+ */
+template<typename T>
+std::vector<T> reverse_copy(std::vector<T> strs) {
+    std::reverse(strs.begin(), strs.end());
+    return strs;
+}
+
+} // namespace strutil
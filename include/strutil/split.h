@@ -0,0 +1,580 @@
+/**
+******************************************************************************
+*
+*  @file       strutil/split.h
+*  @brief      Splitting strings into tokens
+*
+******************************************************************************
+*/
+
+#pragma once
+
+#include "core.h"
+#include "stats.h"
+#include "trim.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory_resource>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace strutil {
+/**
+ * @brief Options of the single-pass strutil::split and strutil::split_views overloads.
+ */
+struct split_options {
+    /** Drop empty tokens (after trimming, if trim_tokens is set). */
+    bool skip_empty = false;
+    /** Remove leading and trailing whitespace from every token, as strutil::trim_view. */
+    bool trim_tokens = false;
+    /** Cut at no more than this many delimiters; the rest of the input becomes the last token. */
+    std::size_t max_splits = std::string_view::npos;
+    /** Look for delimiters from the end, as Python's rsplit; tokens are still returned left to right. */
+    bool from_right = false;
+};
+
+/**
+ * @brief Result of strutil::partition and strutil::rpartition: the parts before and after the delimiter
+ *        and the delimiter itself, all views into the input.
+ */
+struct partition_result {
+    std::string_view before;
+    std::string_view delim;
+    std::string_view after;
+};
+
+namespace detail {
+/**
+ * @brief Calls on_token for every token of s separated by the character delim.
+ * @param s - string that will be splitted.
+ * @param delim - the delimiter.
+ * @param on_token - callable invoked with each token as std::string_view.
+ */
+template<typename OnToken>
+void split_each(std::string_view s, const char delim, OnToken&& on_token) {
+    std::size_t start = 0;
+    while(true) {
+        std::size_t pos = s.find(delim, start);
+        if (pos == std::string_view::npos) {
+            // Final segment (possibly empty if s ended with delim or s is empty)
+            on_token(s.substr(start));
+            break;
+        }
+        on_token(s.substr(start, pos - start));
+        start = pos + 1;
+    }
+}
+
+/**
+ * @brief Calls on_token for every token of str separated by the substring delim.
+ * @param str - string that will be split.
+ * @param delim - the delimiter.
+ * @param on_token - callable invoked with each token as std::string_view.
+ */
+template<typename OnToken>
+void split_each(std::string_view str, std::string_view delim, OnToken&& on_token) {
+    size_t pos_start = 0, pos_end, delim_len = delim.size();
+
+    while ((pos_end = str.find(delim, pos_start)) != std::string::npos) {
+        on_token(str.substr(pos_start, pos_end - pos_start));
+        pos_start = pos_end + delim_len;
+    }
+
+    on_token(str.substr(pos_start));
+}
+
+/**
+ * @brief Calls on_token for every token of str separated by any character of delims.
+ * @param str - string that will be split.
+ * @param delims - the set of delimiter characters.
+ * @param on_token - callable invoked with each token as std::string_view.
+ */
+template<typename OnToken>
+void split_any_each(std::string_view str, std::string_view delims, OnToken&& on_token) {
+    size_t pos_start = 0;
+    for (size_t pos_end = 0; pos_end < str.length(); ++pos_end) {
+        if (delims.find(str[pos_end]) != std::string_view::npos) {
+            on_token(str.substr(pos_start, pos_end - pos_start));
+            pos_start = pos_end + 1;
+        }
+    }
+
+    on_token(str.substr(pos_start));
+}
+
+/**
+ * @brief Calls on_token for every line of str separated by "\n" or "\r\n".
+ * @param str - string that will be split.
+ * @param on_token - callable invoked with each line as std::string_view.
+ */
+template<typename OnToken>
+void split_lines_each(std::string_view str, OnToken&& on_token) {
+    split_each(str, '\n', [&](std::string_view line) {
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        on_token(line);
+    });
+}
+
+/**
+ * @brief Returns the length of a delimiter.
+ */
+constexpr std::size_t delimiter_size(char) {
+    return 1;
+}
+
+constexpr std::size_t delimiter_size(std::string_view delim) {
+    return delim.size();
+}
+
+/**
+ * @brief Returns the position of the first (or, if last is set, the last) occurrence of delim in str.
+ *        An empty delim is never found.
+ */
+template<typename Delim>
+constexpr std::size_t find_delimiter(std::string_view str, Delim delim, bool last) {
+    if (delimiter_size(delim) == 0) {
+        return std::string_view::npos;
+    }
+    return last ? str.rfind(delim) : str.find(delim);
+}
+
+/**
+ * @brief Cuts str around the delimiter found at pos.
+ */
+constexpr partition_result partition_at(std::string_view str, std::size_t pos, std::size_t delim_size) {
+    return {str.substr(0, pos), str.substr(pos, delim_size), str.substr(pos + delim_size)};
+}
+
+/**
+ * @brief Calls on_token for every token of str separated by delim, applying options in the same scan:
+ *        tokens are trimmed and skipped as views, so nothing is copied for the discarded parts.
+ *        With options.from_right the tokens are produced right to left. An empty delim does not split.
+ * @tparam Delim - char or std::string_view.
+ * @param str - string that will be split.
+ * @param delim - the delimiter.
+ * @param options - see strutil::split_options.
+ * @param on_token - callable invoked with each token as std::string_view.
+ */
+template<typename Delim, typename OnToken>
+void split_each(std::string_view str, Delim delim, const split_options& options, OnToken&& on_token) {
+    const std::size_t delim_size = delimiter_size(delim);
+    const auto emit = [&](std::string_view token) {
+        if (options.trim_tokens) {
+            token = trim_view(token);
+        }
+        if (!options.skip_empty || !token.empty()) {
+            on_token(token);
+        }
+    };
+
+    std::size_t splits = 0;
+    std::size_t pos = 0;
+    if (!options.from_right) {
+        std::size_t start = 0;
+        while (delim_size != 0 && splits < options.max_splits && (pos = str.find(delim, start)) != std::string_view::npos) {
+            emit(str.substr(start, pos - start));
+            start = pos + delim_size;
+            ++splits;
+        }
+        emit(str.substr(start));
+    } else {
+        std::size_t end = str.size();
+        while (delim_size != 0 && splits < options.max_splits && end >= delim_size
+               && (pos = str.rfind(delim, end - delim_size)) != std::string_view::npos) {
+            emit(str.substr(pos + delim_size, end - pos - delim_size));
+            end = pos;
+            ++splits;
+        }
+        emit(str.substr(0, end));
+    }
+}
+
+/**
+ * @brief Collects the tokens of detail::split_each with options into a fresh vector, left to right.
+ * @tparam Vector - vector-like container whose value type is constructible from std::string_view.
+ */
+template<typename Vector, typename Delim>
+Vector split_with_options(std::string_view str, Delim delim, const split_options& options) {
+    Vector out;
+    split_each(str, delim, options, [&](std::string_view token) { out.emplace_back(token); });
+    if (options.from_right) {
+        std::reverse(out.begin(), out.end());
+    }
+    return out;
+}
+
+/**
+ * @brief Collects the tokens produced by a split_*_each function into a fresh vector.
+ * @tparam Vector - vector-like container whose value type is constructible from std::string_view.
+ * @param out - empty container receiving the tokens.
+ * @param split_fn - callable taking a per-token callback.
+ * @return out filled with the tokens.
+ */
+template<typename Vector, typename SplitFn>
+Vector collect_tokens(Vector out, SplitFn&& split_fn) {
+    split_fn([&](std::string_view token) { out.emplace_back(token); });
+    return out;
+}
+
+/**
+ * @brief Stores the tokens produced by a split_*_each function into out, reusing the capacity
+ *        of out and of the strings it already holds. out must end up equal to the tokens, so surplus
+ *        strings are erased with their buffers; only the first min(previous size, token count)
+ *        strings keep their capacity.
+ * @tparam Vector - vector-like container of strings.
+ * @param out - container receiving the tokens.
+ * @param split_fn - callable taking a per-token callback.
+ */
+template<typename Vector, typename SplitFn>
+void assign_tokens(Vector& out, SplitFn&& split_fn) {
+    std::size_t count = 0;
+    split_fn([&](std::string_view token) {
+        if (count < out.size()) {
+            out[count].assign(token.data(), token.size());
+        } else {
+            out.emplace_back(token);
+        }
+        ++count;
+    });
+    out.erase(out.begin() + static_cast<std::ptrdiff_t>(count), out.end());
+}
+} // namespace detail
+
+/**
+ * @brief Splits input string according to input character delimiter.
+ * @param s - string that will be splitted.
+ * @param delim - the delimiter.
+ * @return std::vector<std::string> that contains all splitted tokens.
+ */
+inline std::vector<std::string> split(std::string_view s, const char delim) {
+    STRUTIL_STATS_SCOPE(split, s.size());
+    std::vector<std::string> out;
+
+    // Reserve exactly how many tokens we'll produce: #delims + 1
+    out.reserve(1u + static_cast<std::size_t>(std::count(s.begin(), s.end(), delim)));
+    detail::split_each(s, delim, [&](std::string_view token) { out.emplace_back(token); });
+    STRUTIL_STATS_OUTPUT(detail::total_size(out));
+    return out;
+}
+
+/**
+ * @brief Splits input string according to input character delimiter into memory owned by resource.
+ * @param s - string that will be splitted.
+ * @param delim - the delimiter.
+ * @param resource - memory resource used for the vector and every token.
+ * @return std::pmr::vector<std::pmr::string> that contains all splitted tokens.
+ */
+inline std::pmr::vector<std::pmr::string> split(std::string_view s, const char delim, std::pmr::memory_resource* resource) {
+    STRUTIL_STATS_SCOPE(split, s.size());
+    std::pmr::vector<std::pmr::string> out{resource};
+    out.reserve(1u + static_cast<std::size_t>(std::count(s.begin(), s.end(), delim)));
+    detail::split_each(s, delim, [&](std::string_view token) { out.emplace_back(token); });
+    STRUTIL_STATS_OUTPUT(detail::total_size(out));
+    return out;
+}
+
+/**
+ * @brief Splits input string according to input character delimiter into out, reusing the capacity
+ *        of out and of the strings it already holds. Once warmed up, splitting inputs with the same token
+ *        count and similar token lengths does not allocate. When the token count drops, the surplus
+ *        strings are destroyed (the vector keeps its capacity), so their buffers are allocated again
+ *        when the count grows back.
+ * @param s - string that will be splitted.
+ * @param delim - the delimiter.
+ * @param out - receives all splitted tokens; previous contents are overwritten.
+ */
+inline void split_into(std::string_view s, const char delim, std::vector<std::string>& out) {
+    STRUTIL_STATS_SCOPE(split_into, s.size());
+    detail::assign_tokens(out, [&](auto&& on_token) { detail::split_each(s, delim, on_token); });
+    STRUTIL_STATS_OUTPUT(detail::total_size(out));
+}
+
+/**
+ * @brief Splits input string according to input delimiter substring.
+ *        Taken from: https://stackoverflow.com/a/46931770/1892346.
+ * @param str - string that will be split.
+ * @param delim - the delimiter.
+ * @return std::vector<std::string> that contains all splitted tokens.
+ */
+inline std::vector<std::string> split(std::string_view str, std::string_view delim) {
+    STRUTIL_STATS_SCOPE(split, str.size());
+    auto tokens = detail::collect_tokens(std::vector<std::string>{},
+                                         [&](auto&& on_token) { detail::split_each(str, delim, on_token); });
+    STRUTIL_STATS_OUTPUT(detail::total_size(tokens));
+    return tokens;
+}
+
+/**
+ * @brief Splits input string according to input delimiter substring into memory owned by resource.
+ * @param str - string that will be split.
+ * @param delim - the delimiter.
+ * @param resource - memory resource used for the vector and every token.
+ * @return std::pmr::vector<std::pmr::string> that contains all splitted tokens.
+ */
+inline std::pmr::vector<std::pmr::string> split(std::string_view str, std::string_view delim, std::pmr::memory_resource* resource) {
+    STRUTIL_STATS_SCOPE(split, str.size());
+    auto tokens = detail::collect_tokens(std::pmr::vector<std::pmr::string>{resource},
+                                         [&](auto&& on_token) { detail::split_each(str, delim, on_token); });
+    STRUTIL_STATS_OUTPUT(detail::total_size(tokens));
+    return tokens;
+}
+
+/**
+ * @brief Splits input string according to input delimiter substring into out, reusing the capacity
+ *        of out and of the strings it already holds.
+ * @param str - string that will be split.
+ * @param delim - the delimiter.
+ * @param out - receives all splitted tokens; previous contents are overwritten, see strutil::split_into
+ *              for which buffers are reused.
+ */
+inline void split_into(std::string_view str, std::string_view delim, std::vector<std::string>& out) {
+    STRUTIL_STATS_SCOPE(split_into, str.size());
+    detail::assign_tokens(out, [&](auto&& on_token) { detail::split_each(str, delim, on_token); });
+    STRUTIL_STATS_OUTPUT(detail::total_size(out));
+}
+
+/**
+ * @brief Splits input string according to input character delimiter, skipping empty tokens, trimming
+ *        tokens and limiting the number of splits as requested, in a single pass over str.
+ * @param str - string that will be split.
+ * @param delim - the delimiter.
+ * @param options - see strutil::split_options.
+ * @return std::vector<std::string> that contains the tokens, left to right.
+ */
+inline std::vector<std::string> split(std::string_view str, const char delim, const split_options& options) {
+    STRUTIL_STATS_SCOPE(split, str.size());
+    auto tokens = detail::split_with_options<std::vector<std::string>>(str, delim, options);
+    STRUTIL_STATS_OUTPUT(detail::total_size(tokens));
+    return tokens;
+}
+
+/**
+ * @brief Splits input string according to input delimiter substring in a single pass over str,
+ *        see strutil::split_options.
+ * @param str - string that will be split.
+ * @param delim - the delimiter.
+ * @param options - see strutil::split_options.
+ * @return std::vector<std::string> that contains the tokens, left to right.
+ */
+inline std::vector<std::string> split(std::string_view str, std::string_view delim, const split_options& options) {
+    STRUTIL_STATS_SCOPE(split, str.size());
+    auto tokens = detail::split_with_options<std::vector<std::string>>(str, delim, options);
+    STRUTIL_STATS_OUTPUT(detail::total_size(tokens));
+    return tokens;
+}
+
+/**
+ * @brief Splits input string according to input character delimiter without copying the tokens.
+ * @param str - string that will be split; must outlive the result.
+ * @param delim - the delimiter.
+ * @param options - see strutil::split_options.
+ * @return std::vector<std::string_view> of tokens pointing into str, left to right.
+ */
+inline std::vector<std::string_view> split_views(std::string_view str, const char delim, const split_options& options = split_options()) {
+    STRUTIL_STATS_SCOPE(split_views, str.size());
+    auto tokens = detail::split_with_options<std::vector<std::string_view>>(str, delim, options);
+    STRUTIL_STATS_OUTPUT(detail::total_size(tokens));
+    return tokens;
+}
+
+/**
+ * @brief Splits input string according to input delimiter substring without copying the tokens.
+ * @param str - string that will be split; must outlive the result.
+ * @param delim - the delimiter.
+ * @param options - see strutil::split_options.
+ * @return std::vector<std::string_view> of tokens pointing into str, left to right.
+ */
+inline std::vector<std::string_view> split_views(std::string_view str, std::string_view delim, const split_options& options = split_options()) {
+    STRUTIL_STATS_SCOPE(split_views, str.size());
+    auto tokens = detail::split_with_options<std::vector<std::string_view>>(str, delim, options);
+    STRUTIL_STATS_OUTPUT(detail::total_size(tokens));
+    return tokens;
+}
+
+/**
+ * @brief Splits input string into lines separated by "\n" or "\r\n".
+ * @param str - string that will be split.
+ * @return std::vector<std::string> that contains the lines.
+ */
+inline std::vector<std::string> split_lines(std::string_view str) {
+    STRUTIL_STATS_SCOPE(split_lines, str.size());
+    auto tokens = detail::collect_tokens(std::vector<std::string>{},
+                                         [&](auto&& on_token) { detail::split_lines_each(str, on_token); });
+    STRUTIL_STATS_OUTPUT(detail::total_size(tokens));
+    return tokens;
+}
+
+/**
+ * @brief Splits input string into lines separated by "\n" or "\r\n" into memory owned by resource.
+ * @param str - string that will be split.
+ * @param resource - memory resource used for the vector and every line.
+ * @return std::pmr::vector<std::pmr::string> that contains the lines.
+ */
+inline std::pmr::vector<std::pmr::string> split_lines(std::string_view str, std::pmr::memory_resource* resource) {
+    STRUTIL_STATS_SCOPE(split_lines, str.size());
+    auto tokens = detail::collect_tokens(std::pmr::vector<std::pmr::string>{resource},
+                                         [&](auto&& on_token) { detail::split_lines_each(str, on_token); });
+    STRUTIL_STATS_OUTPUT(detail::total_size(tokens));
+    return tokens;
+}
+
+/**
+ * @brief Splits input string into lines separated by "\n" or "\r\n" into out, reusing the capacity
+ *        of out and of the strings it already holds.
+ * @param str - string that will be split.
+ * @param out - receives the lines; previous contents are overwritten, see strutil::split_into
+ *              for which buffers are reused.
+ */
+inline void split_lines_into(std::string_view str, std::vector<std::string>& out) {
+    STRUTIL_STATS_SCOPE(split_lines_into, str.size());
+    detail::assign_tokens(out, [&](auto&& on_token) { detail::split_lines_each(str, on_token); });
+    STRUTIL_STATS_OUTPUT(detail::total_size(out));
+}
+
+/**
+ * @brief Splits input string into lines separated by "\n" or "\r\n", trims them and removes empty lines.
+ * @param str - string that will be split.
+ * @return std::vector<std::string> that contains trimmed non-empty lines.
+ */
+inline std::vector<std::string> split_lines_clean(std::string_view str) {
+    std::vector<std::string> tokens;
+    std::stringstream ss{std::string(str)};
+
+    std::string token;
+    while (std::getline(ss, token)) {
+        trim(token);
+        if (!token.empty()) {
+            tokens.emplace_back(std::move(token));
+        }
+    }
+
+    return tokens;
+}
+
+/**
+ * @brief Splits input string using any delimiter in the given set.
+ * @param str - string that will be split.
+ * @param delims - the set of delimiter characters.
+ * @return vector of resulting tokens.
+ */
+inline std::vector<std::string> split_any(std::string_view str, std::string_view delims) {
+    STRUTIL_STATS_SCOPE(split_any, str.size());
+    auto tokens = detail::collect_tokens(std::vector<std::string>{},
+                                         [&](auto&& on_token) { detail::split_any_each(str, delims, on_token); });
+    STRUTIL_STATS_OUTPUT(detail::total_size(tokens));
+    return tokens;
+}
+
+/**
+ * @brief Splits input string using any delimiter in the given set into memory owned by resource.
+ * @param str - string that will be split.
+ * @param delims - the set of delimiter characters.
+ * @param resource - memory resource used for the vector and every token.
+ * @return std::pmr::vector<std::pmr::string> of resulting tokens.
+ */
+inline std::pmr::vector<std::pmr::string> split_any(std::string_view str, std::string_view delims, std::pmr::memory_resource* resource) {
+    STRUTIL_STATS_SCOPE(split_any, str.size());
+    auto tokens = detail::collect_tokens(std::pmr::vector<std::pmr::string>{resource},
+                                         [&](auto&& on_token) { detail::split_any_each(str, delims, on_token); });
+    STRUTIL_STATS_OUTPUT(detail::total_size(tokens));
+    return tokens;
+}
+
+/**
+ * @brief Splits input string using any delimiter in the given set into out, reusing the capacity
+ *        of out and of the strings it already holds.
+ * @param str - string that will be split.
+ * @param delims - the set of delimiter characters.
+ * @param out - receives the tokens; previous contents are overwritten, see strutil::split_into
+ *              for which buffers are reused.
+ */
+inline void split_any_into(std::string_view str, std::string_view delims, std::vector<std::string>& out) {
+    STRUTIL_STATS_SCOPE(split_any_into, str.size());
+    detail::assign_tokens(out, [&](auto&& on_token) { detail::split_any_each(str, delims, on_token); });
+    STRUTIL_STATS_OUTPUT(detail::total_size(out));
+}
+
+/**
+ * @brief Splits str around the first occurrence of delim without copying or allocating.
+ * @param str - string that will be split; must outlive the result.
+ * @param delim - the delimiter, a char or a substring.
+ * @return {before, delim, after}; {str, "", ""} if delim does not occur in str or is empty.
+ */
+constexpr partition_result partition(std::string_view str, char delim) {
+    const std::size_t pos = detail::find_delimiter(str, delim, false);
+    return pos == std::string_view::npos ? partition_result{str, {}, {}} : detail::partition_at(str, pos, 1);
+}
+
+constexpr partition_result partition(std::string_view str, std::string_view delim) {
+    const std::size_t pos = detail::find_delimiter(str, delim, false);
+    return pos == std::string_view::npos ? partition_result{str, {}, {}} : detail::partition_at(str, pos, delim.size());
+}
+
+/**
+ * @brief Splits str around the last occurrence of delim without copying or allocating.
+ * @param str - string that will be split; must outlive the result.
+ * @param delim - the delimiter, a char or a substring.
+ * @return {before, delim, after}; {"", "", str} if delim does not occur in str or is empty.
+ */
+constexpr partition_result rpartition(std::string_view str, char delim) {
+    const std::size_t pos = detail::find_delimiter(str, delim, true);
+    return pos == std::string_view::npos ? partition_result{{}, {}, str} : detail::partition_at(str, pos, 1);
+}
+
+constexpr partition_result rpartition(std::string_view str, std::string_view delim) {
+    const std::size_t pos = detail::find_delimiter(str, delim, true);
+    return pos == std::string_view::npos ? partition_result{{}, {}, str} : detail::partition_at(str, pos, delim.size());
+}
+
+/**
+ * @brief Splits str at the first occurrence of delim without copying or allocating.
+ * @param str - string that will be split; must outlive the result.
+ * @param delim - the delimiter, a char or a substring.
+ * @return The parts before and after delim, or std::nullopt if delim does not occur in str or is empty.
+ */
+constexpr std::optional<std::pair<std::string_view, std::string_view>> split_once(std::string_view str, char delim) {
+    const std::size_t pos = detail::find_delimiter(str, delim, false);
+    if (pos == std::string_view::npos) {
+        return std::nullopt;
+    }
+    return std::pair<std::string_view, std::string_view>{str.substr(0, pos), str.substr(pos + 1)};
+}
+
+constexpr std::optional<std::pair<std::string_view, std::string_view>> split_once(std::string_view str, std::string_view delim) {
+    const std::size_t pos = detail::find_delimiter(str, delim, false);
+    if (pos == std::string_view::npos) {
+        return std::nullopt;
+    }
+    return std::pair<std::string_view, std::string_view>{str.substr(0, pos), str.substr(pos + delim.size())};
+}
+
+/**
+ * @brief Splits str at the last occurrence of delim without copying or allocating.
+ * @param str - string that will be split; must outlive the result.
+ * @param delim - the delimiter, a char or a substring.
+ * @return The parts before and after delim, or std::nullopt if delim does not occur in str or is empty.
+ */
+constexpr std::optional<std::pair<std::string_view, std::string_view>> rsplit_once(std::string_view str, char delim) {
+    const std::size_t pos = detail::find_delimiter(str, delim, true);
+    if (pos == std::string_view::npos) {
+        return std::nullopt;
+    }
+    return std::pair<std::string_view, std::string_view>{str.substr(0, pos), str.substr(pos + 1)};
+}
+
+constexpr std::optional<std::pair<std::string_view, std::string_view>> rsplit_once(std::string_view str, std::string_view delim) {
+    const std::size_t pos = detail::find_delimiter(str, delim, true);
+    if (pos == std::string_view::npos) {
+        return std::nullopt;
+    }
+    return std::pair<std::string_view, std::string_view>{str.substr(0, pos), str.substr(pos + delim.size())};
+}
+
+} // namespace strutil
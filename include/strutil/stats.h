@@ -0,0 +1,304 @@
+/**
+******************************************************************************
+*
+*  @file       strutil/stats.h
+*  @brief      Opt-in per-function call, byte and latency statistics (STRUTIL_ENABLE_STATS)
+*
+******************************************************************************
+*/
+
+#pragma once
+
+#include "core.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#if defined(STRUTIL_ENABLE_STATS)
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iterator>
+#include <mutex>
+#endif
+
+// Instrumentation of the strutil functions: declares the statistics scope of the enclosing call and
+// adds to its byte counters. Expands to nothing unless STRUTIL_ENABLE_STATS is defined, so the byte
+// counts are not even computed by default.
+#if defined(STRUTIL_ENABLE_STATS)
+#define STRUTIL_STATS_SCOPE(function, input_bytes)                                                            \
+    ::strutil::detail::stats_scope strutil_stats_scope_(::strutil::detail::stats_function::function, (input_bytes))
+#define STRUTIL_STATS_INPUT(input_bytes) strutil_stats_scope_.add_input_bytes(input_bytes)
+#define STRUTIL_STATS_OUTPUT(output_bytes) strutil_stats_scope_.add_output_bytes(output_bytes)
+#else
+#define STRUTIL_STATS_SCOPE(function, input_bytes) static_cast<void>(0)
+#define STRUTIL_STATS_INPUT(input_bytes) static_cast<void>(0)
+#define STRUTIL_STATS_OUTPUT(output_bytes) static_cast<void>(0)
+#endif
+
+namespace strutil {
+namespace detail {
+inline constexpr std::size_t STATS_LATENCY_BUCKETS = 32;
+} // namespace detail
+
+/**
+ * @brief Totals of one instrumented function over all threads, as returned by strutil::stats_snapshot.
+ */
+struct function_stats {
+    std::string_view name;
+    std::uint64_t calls = 0;
+    std::uint64_t input_bytes = 0;
+    std::uint64_t output_bytes = 0;
+    //! Number of calls whose latency was measured, see strutil::set_stats_sampling.
+    std::uint64_t sampled_calls = 0;
+    //! Sampled calls by duration: bucket i counts durations in [2^i, 2^(i+1)) nanoseconds,
+    //! bucket 0 also the shorter ones and the last bucket also the longer ones.
+    std::uint64_t latency_histogram[detail::STATS_LATENCY_BUCKETS] = {};
+};
+
+#if defined(STRUTIL_ENABLE_STATS)
+namespace detail {
+/**
+ * @brief The instrumented functions, in the order of STATS_FUNCTION_NAMES. All overloads of a function
+ *        share one entry.
+ */
+enum class stats_function : unsigned char {
+    escape_c,
+    escape_json,
+    from_base64,
+    join,
+    preview,
+    replace_all,
+    split,
+    split_any,
+    split_any_into,
+    split_into,
+    split_lines,
+    split_lines_into,
+    split_views,
+    to_base64,
+    to_lower,
+    to_upper,
+    truncate,
+    unescape_c,
+};
+
+inline constexpr std::size_t STATS_FUNCTION_COUNT = 18;
+inline constexpr std::string_view STATS_FUNCTION_NAMES[STATS_FUNCTION_COUNT] = {
+    "escape_c", "escape_json", "from_base64", "join", "preview", "replace_all", "split", "split_any",
+    "split_any_into", "split_into", "split_lines", "split_lines_into", "split_views", "to_base64",
+    "to_lower", "to_upper", "truncate", "unescape_c"};
+
+/**
+ * @brief Counters of one function in one thread. Only the owning thread writes them, so increments
+ *        are a plain load and store; the atomics only let strutil::stats_snapshot read them meanwhile.
+ */
+struct stats_counters {
+    std::atomic<std::uint64_t> calls{0};
+    std::atomic<std::uint64_t> input_bytes{0};
+    std::atomic<std::uint64_t> output_bytes{0};
+    std::atomic<std::uint64_t> sampled_calls{0};
+    std::atomic<std::uint64_t> latency_histogram[STATS_LATENCY_BUCKETS] = {};
+};
+
+inline void add_counter(std::atomic<std::uint64_t>& counter, std::uint64_t value) {
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+inline void add_counters(function_stats& total, const stats_counters& counters) {
+    total.calls += counters.calls.load(std::memory_order_relaxed);
+    total.input_bytes += counters.input_bytes.load(std::memory_order_relaxed);
+    total.output_bytes += counters.output_bytes.load(std::memory_order_relaxed);
+    total.sampled_calls += counters.sampled_calls.load(std::memory_order_relaxed);
+    for (std::size_t i = 0; i < STATS_LATENCY_BUCKETS; ++i) {
+        total.latency_histogram[i] += counters.latency_histogram[i].load(std::memory_order_relaxed);
+    }
+}
+
+struct thread_stats;
+
+/**
+ * @brief The live threads' counters, and the totals of the threads that have exited.
+ */
+struct stats_registry_state {
+    std::mutex mutex;
+    std::vector<const thread_stats*> threads;
+    function_stats exited[STATS_FUNCTION_COUNT];
+    //! Measure the latency of every n-th call of a thread, 0 for none.
+    std::atomic<std::uint32_t> sampling_period{0};
+};
+
+inline stats_registry_state& stats_registry() {
+    static stats_registry_state registry;
+    return registry;
+}
+
+/**
+ * @brief The counters of the calling thread, registered while the thread runs and added to the
+ *        exited totals when it ends.
+ */
+struct thread_stats {
+    stats_counters functions[STATS_FUNCTION_COUNT];
+    std::uint32_t calls_since_sample = 0;
+
+    thread_stats() {
+        stats_registry_state& registry = stats_registry();
+        const std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.threads.push_back(this);
+    }
+
+    ~thread_stats() {
+        stats_registry_state& registry = stats_registry();
+        const std::lock_guard<std::mutex> lock(registry.mutex);
+        for (std::size_t i = 0; i < STATS_FUNCTION_COUNT; ++i) {
+            add_counters(registry.exited[i], functions[i]);
+        }
+        registry.threads.erase(std::find(registry.threads.begin(), registry.threads.end(), this));
+    }
+
+    thread_stats(const thread_stats&) = delete;
+    thread_stats& operator=(const thread_stats&) = delete;
+};
+
+inline thread_stats& local_stats() {
+    thread_local thread_stats stats;
+    return stats;
+}
+
+/**
+ * @brief Counts one call of a function for its lifetime: the call and its input bytes on
+ *        construction, the output bytes and, for sampled calls, the latency on destruction.
+ */
+class stats_scope {
+public:
+    stats_scope(stats_function function, std::size_t input_bytes)
+        : thread_(local_stats()), counters_(thread_.functions[static_cast<std::size_t>(function)]) {
+        add_counter(counters_.calls, 1);
+        add_counter(counters_.input_bytes, input_bytes);
+        const std::uint32_t period = stats_registry().sampling_period.load(std::memory_order_relaxed);
+        if (period != 0 && ++thread_.calls_since_sample >= period) {
+            thread_.calls_since_sample = 0;
+            sampled_ = true;
+            start_ = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~stats_scope() {
+        if (sampled_) {
+            const auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start_).count();
+            std::size_t bucket = 0;
+            for (auto rest = static_cast<std::uint64_t>(nanoseconds) >> 1; rest != 0 && bucket + 1 < STATS_LATENCY_BUCKETS;
+                 rest >>= 1) {
+                ++bucket;
+            }
+            add_counter(counters_.sampled_calls, 1);
+            add_counter(counters_.latency_histogram[bucket], 1);
+        }
+    }
+
+    stats_scope(const stats_scope&) = delete;
+    stats_scope& operator=(const stats_scope&) = delete;
+
+    void add_input_bytes(std::size_t bytes) {
+        add_counter(counters_.input_bytes, bytes);
+    }
+
+    void add_output_bytes(std::size_t bytes) {
+        add_counter(counters_.output_bytes, bytes);
+    }
+
+private:
+    thread_stats& thread_;
+    stats_counters& counters_;
+    bool sampled_ = false;
+    std::chrono::steady_clock::time_point start_;
+};
+
+/**
+ * @brief Returns the number of delimiters strutil::join puts between the tokens of a container.
+ */
+template<typename Container>
+std::size_t separator_count(const Container& tokens) {
+    const auto count = static_cast<std::size_t>(std::distance(std::begin(tokens), std::end(tokens)));
+    return count == 0 ? 0 : count - 1;
+}
+
+/**
+ * @brief Returns the total size of the strings of a container, the output bytes of the split functions.
+ */
+template<typename Container>
+std::size_t total_size(const Container& strs) {
+    std::size_t size = 0;
+    for (const auto& str : strs) {
+        size += str.size();
+    }
+    return size;
+}
+} // namespace detail
+#endif
+
+/**
+ * @brief Tells whether the library was built with STRUTIL_ENABLE_STATS. Without it, strutil functions
+ *        are not instrumented at all and strutil::stats_snapshot returns nothing.
+ */
+inline constexpr bool stats_enabled() {
+#if defined(STRUTIL_ENABLE_STATS)
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Measures the latency of every period-th call a thread makes to an instrumented function,
+ *        e.g. 1024 to keep the clock reads negligible. Sampling is off by default.
+ * @param period - sampling period, 0 to stop measuring latencies.
+ */
+inline void set_stats_sampling(std::uint32_t period) {
+#if defined(STRUTIL_ENABLE_STATS)
+    detail::stats_registry().sampling_period.store(period, std::memory_order_relaxed);
+#else
+    static_cast<void>(period);
+#endif
+}
+
+/**
+ * @brief Adds up the counters of all threads, including the threads that have exited. Counters
+ *        are read while other threads keep updating them, so concurrent calls may or may not be
+ *        included. Calls made by other strutil functions are counted as well, e.g. preview also
+ *        counts an escape_c and a truncate call.
+ *        Instrumented are escape_c, escape_json, from_base64, join, preview, replace_all, split,
+ *        split_any, split_any_into, split_into, split_lines, split_lines_into, split_views, to_base64,
+ *        to_lower, to_upper, truncate and unescape_c; the other functions, e.g. split_lines_clean,
+ *        the UTF-8, comparison and parsing functions, are not counted.
+ * @return One entry per instrumented function that has been called, sorted by name; empty unless
+ *         STRUTIL_ENABLE_STATS is defined.
+ */
+inline std::vector<function_stats> stats_snapshot() {
+    std::vector<function_stats> snapshot;
+#if defined(STRUTIL_ENABLE_STATS)
+    detail::stats_registry_state& registry = detail::stats_registry();
+    function_stats totals[detail::STATS_FUNCTION_COUNT];
+    {
+        const std::lock_guard<std::mutex> lock(registry.mutex);
+        for (std::size_t i = 0; i < detail::STATS_FUNCTION_COUNT; ++i) {
+            totals[i] = registry.exited[i];
+            for (const detail::thread_stats* thread : registry.threads) {
+                detail::add_counters(totals[i], thread->functions[i]);
+            }
+        }
+    }
+    for (std::size_t i = 0; i < detail::STATS_FUNCTION_COUNT; ++i) {
+        if (totals[i].calls != 0) {
+            totals[i].name = detail::STATS_FUNCTION_NAMES[i];
+            snapshot.push_back(totals[i]);
+        }
+    }
+#endif
+    return snapshot;
+}
+
+} // namespace strutil
@@ -0,0 +1,466 @@
+/**
+******************************************************************************
+*
+*  @file       strutil/text.h
+*  @brief      Replacing, joining, repeating, truncating, previewing and template rendering
+*
+******************************************************************************
+*/
+
+#pragma once
+
+#include "core.h"
+#include "builder.h"
+#include "encode.h"
+#include "stats.h"
+
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <memory_resource>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace strutil {
+/**
+ * @brief Replaces (in-place) the first occurance of target with replacement.
+ *        Taken from: http://stackoverflow.com/questions/3418231/c-replace-part-of-a-string-with-another-string.
+ * @param str - input std::string that will be modified.
+ * @param target - substring that will be replaced with replacement.
+ * @param replecament - substring that will replace target.
+ * @return True if replacement was successful, false otherwise.
+ */
+inline bool replace_first(std::string& str, const std::string& target, const std::string& replecament) {
+    size_t start_pos = str.find(target);
+    if (start_pos == std::string::npos) {
+        return false;
+    }
+
+    str.replace(start_pos, target.length(), replecament);
+    return true;
+}
+
+/**
+ * @brief Replaces (in-place) last occurance of target with replacement.
+ *        Taken from: http://stackoverflow.com/questions/3418231/c-replace-part-of-a-string-with-another-string.
+ * @param str - input std::string that will be modified.
+ * @param target - substring that will be replaced with replacement.
+ * @param replecament - substring that will replace target.
+ * @return True if replacement was successful, false otherwise.
+ */
+inline bool replace_last(std::string& str, const std::string& target, const std::string& replecament) {
+    size_t start_pos = str.rfind(target);
+    if (start_pos == std::string::npos) {
+        return false;
+    }
+
+    str.replace(start_pos, target.length(), replecament);
+    return true;
+}
+
+/**
+ * @brief Replaces (in-place) all occurances of target with replacement.
+ *        Taken from: http://stackoverflow.com/questions/3418231/c-replace-part-of-a-string-with-another-string.
+ * @tparam Allocator - allocator of str, e.g. std::pmr::polymorphic_allocator<char> for std::pmr::string.
+ * @param str - input std::string that will be modified.
+ * @param target - substring that will be replaced with replacement.
+ * @param replacement - substring that will replace target.
+ * @return True if replacement was successful, false otherwise.
+ */
+template<typename Allocator>
+bool replace_all(std::basic_string<char, std::char_traits<char>, Allocator>& str,
+                        std::string_view target,
+                        std::string_view replacement) {
+    STRUTIL_STATS_SCOPE(replace_all, str.size());
+    if (str.empty() || target.empty()) {
+        STRUTIL_STATS_OUTPUT(str.size());
+        return false;
+    }
+
+    size_t start_pos = 0;
+    const bool found_substring = str.find(target, start_pos) != std::string::npos;
+
+    while ((start_pos = str.find(target, start_pos)) != std::string::npos) {
+        str.replace(start_pos, target.length(), replacement);
+        start_pos += replacement.length();
+    }
+
+    STRUTIL_STATS_OUTPUT(str.size());
+    return found_substring;
+}
+
+/**
+ * @brief Joins all elements of std::vector tokens of arbitrary datatypes
+ *        into one std::string with delimiter delim.
+ * @tparam Container - type of iterable container.
+ * @param tokens - container of tokens. @note that int8_t and uint8_t are treated as int.
+ * @param delim - the delimiter.
+ * @return std::string with joined elements of vector tokens with delimiter delim.
+ */
+template<typename Container>
+std::string join(const Container& tokens, std::string_view delim) {
+    STRUTIL_STATS_SCOPE(join, 0);
+    string_builder result;
+    for (auto it = tokens.begin(); it != tokens.end(); ++it) {
+        if (it != tokens.begin()) {
+            result.append(delim);
+        }
+
+        // treat Container<int8_t> and Container<uint8_t> as Container<int>
+        using ValueType = std::decay_t<decltype(*it)>;
+        if constexpr (std::is_same_v<ValueType, int8_t> || std::is_same_v<ValueType, uint8_t>) {
+            result << static_cast<int>(*it);
+        } else {
+            result << *it;
+        }
+    }
+
+    // the rendered tokens count as input
+    STRUTIL_STATS_INPUT(result.size() - delim.size() * detail::separator_count(tokens));
+    STRUTIL_STATS_OUTPUT(result.size());
+    return result.str();
+}
+
+/**
+ * @brief Joins all elements of container tokens into one std::pmr::string allocated from resource.
+ *        String-like tokens are appended directly; other tokens are rendered the same way as strutil::join.
+ * @tparam Container - type of iterable container.
+ * @param tokens - container of tokens.
+ * @param delim - the delimiter.
+ * @param resource - memory resource used for the result.
+ * @return std::pmr::string with joined elements of container tokens with delimiter delim.
+ */
+template<typename Container>
+std::pmr::string join(const Container& tokens, std::string_view delim, std::pmr::memory_resource* resource) {
+    using ValueType = std::decay_t<decltype(*std::begin(tokens))>;
+    if constexpr (!std::is_convertible_v<const ValueType&, std::string_view>) {
+        return std::pmr::string(join(tokens, delim), resource);
+    } else {
+        std::size_t total_size = 0;
+        for (auto it = tokens.begin(); it != tokens.end(); ++it) {
+            total_size += (it != tokens.begin() ? delim.size() : 0) + std::string_view(*it).size();
+        }
+
+        STRUTIL_STATS_SCOPE(join, total_size - delim.size() * detail::separator_count(tokens));
+        STRUTIL_STATS_OUTPUT(total_size);
+        std::pmr::string result{resource};
+        result.reserve(total_size);
+        for (auto it = tokens.begin(); it != tokens.end(); ++it) {
+            if (it != tokens.begin()) {
+                result.append(delim);
+            }
+            result.append(std::string_view(*it));
+        }
+
+        return result;
+    }
+}
+
+/**
+ * @brief Joins all elements of a container of streamable objects into one std::string with delimiter delim.
+ * @tparam Container - type of iterable container whose value type supports operator<<(std::ostream&, Value).
+ * @param tokens - container of values to join.
+ * @param delim - delimiter inserted between values.
+ * @return std::string with joined elements of container tokens with delimiter delim.
+ */
+template<typename Container>
+std::string join_objects(const Container& tokens, std::string_view delim) {
+    using ValueType = std::decay_t<decltype(*std::begin(tokens))>;
+    static_assert(std::is_convertible_v<decltype(std::declval<std::ostream&>() << std::declval<ValueType>()), std::ostream&>,
+                  "join_objects requires values stream-insertable into std::ostream");
+
+    string_builder result;
+    for (auto it = tokens.begin(); it != tokens.end(); ++it) {
+        if (it != tokens.begin()) {
+            result.append(delim);
+        }
+        result << *it;
+    }
+
+    return result.str();
+}
+
+/**
+ * @brief Inplace removal of all empty strings in a vector<string>
+ * @param tokens - vector of strings.
+ */
+inline void drop_empty(std::vector<std::string>& tokens) {
+    auto last = std::remove_if(tokens.begin(), tokens.end(), [](const std::string& s) { return s.empty(); });
+    tokens.erase(last, tokens.end());
+}
+
+/**
+ * @brief Inplace removal of all empty strings in a vector<string>
+ * @param tokens - vector of strings.
+ * @return vector of non-empty tokens.
+ */
+inline std::vector<std::string> drop_empty_copy(std::vector<std::string> tokens) {
+    drop_empty(tokens);
+    return tokens;
+}
+
+/** 
+ * @brief Creates new std::string with repeated n times substring str.
+ * @param str - substring that needs to be repeated.
+ * @param n - number of iterations.
+ * @return std::string with repeated substring str.
+ */
+inline std::string repeat(std::string_view str, unsigned n) {
+    std::string result(str.size() * n, '\0');
+    detail::fill_repeated(result.data(), str, n);
+    return result;
+}
+
+/**
+ * @brief Creates new std::string with repeated n times char c.
+ * @param c - char that needs to be repeated.
+ * @param n - number of iterations.
+ * @return std::string with repeated char c.
+ */
+inline std::string repeat(char c, unsigned n) {
+    return std::string(n, c);
+}
+
+/**
+ * @brief Creates new std::pmr::string allocated from resource with repeated n times substring str.
+ * @param str - substring that needs to be repeated.
+ * @param n - number of iterations.
+ * @param resource - memory resource used for the result.
+ * @return std::pmr::string with repeated substring str.
+ */
+inline std::pmr::string repeat(std::string_view str, unsigned n, std::pmr::memory_resource* resource) {
+    std::pmr::string result(str.size() * n, '\0', resource);
+    detail::fill_repeated(result.data(), str, n);
+    return result;
+}
+
+/**
+ * @brief Creates new std::pmr::string allocated from resource with repeated n times char c.
+ * @param c - char that needs to be repeated.
+ * @param n - number of iterations.
+ * @param resource - memory resource used for the result.
+ * @return std::pmr::string with repeated char c.
+ */
+inline std::pmr::string repeat(char c, unsigned n, std::pmr::memory_resource* resource) {
+    return std::pmr::string(n, c, resource);
+}
+
+/**
+ * @brief Truncates the source string so that the result does not exceed
+ *        max_output_string_length characters. If truncation happens, the
+ *        ellipsis string is appended to the truncated substring.
+ * @param source_string - the input string that may need to be truncated.
+ * @param max_output_string_length - maximum length of the returned string.
+ * @param ellipsis - string appended when truncation occurs.
+ * @return Truncated string with optional ellipsis.
+ */
+inline std::string truncate(std::string_view source_string,
+                                   size_t max_output_string_length = 100,
+                                   std::string_view ellipsis = "...") {
+    STRUTIL_STATS_SCOPE(truncate, source_string.size());
+    if (source_string.size() <= max_output_string_length) {
+        STRUTIL_STATS_OUTPUT(source_string.size());
+        return std::string(source_string);
+    }
+
+    if (max_output_string_length <= ellipsis.size()) {
+        STRUTIL_STATS_OUTPUT(max_output_string_length);
+        return std::string(ellipsis.substr(0, max_output_string_length));
+    }
+
+    std::string result(source_string.substr(0, max_output_string_length - ellipsis.size()));
+    result.append(ellipsis);
+    STRUTIL_STATS_OUTPUT(result.size());
+    return result;
+}
+
+/**
+ * @brief Produce a sanitized preview of the input string where non-printable
+ *        characters are replaced with escape sequences. The result is then
+ *        truncated using the same rules as strutil::truncate.
+ *
+ * @param source_string - the input string that may contain non-printable
+ *                        characters.
+ * @param max_output_string_length - maximum length of the returned string.
+ * @param ellipsis - string appended when truncation occurs.
+ * @return Sanitized and possibly truncated string.
+ */
+inline std::string preview(std::string_view source_string,
+                                  size_t max_output_string_length = 100,
+                                  std::string_view ellipsis = "...") {
+    STRUTIL_STATS_SCOPE(preview, source_string.size());
+    std::string result = truncate(escape_c(source_string), max_output_string_length, ellipsis);
+    STRUTIL_STATS_OUTPUT(result.size());
+    return result;
+}
+
+namespace detail {
+template<typename T, typename = void>
+struct is_map_like : std::false_type {};
+
+template<typename T>
+struct is_map_like<T, std::void_t<typename T::key_type, typename T::mapped_type>> : std::true_type {};
+} // namespace detail
+
+/**
+ * @brief A text template with {name} placeholders, parsed once and rendered many times.
+ *        "{{" and "}}" stand for literal braces; a '{' without a matching '}' and an empty "{}" are
+ *        kept as literal text. Rendering looks every distinct name up once, computes the exact output
+ *        size and copies literals and values in a single pass, instead of rescanning the text once
+ *        per placeholder as a strutil::replace_all loop does.
+ */
+class template_string {
+public:
+    /**
+     * @brief Parses the template.
+     * @param pattern - template text, e.g. "Hello {user}, you have {count} new messages".
+     */
+    explicit template_string(std::string_view pattern) {
+        std::size_t literal_start = 0;
+        std::size_t i = 0;
+        while (i < pattern.size()) {
+            const char c = pattern[i];
+            if ((c == '{' || c == '}') && i + 1 < pattern.size() && pattern[i + 1] == c) {
+                text_.push_back(c);
+                i += 2;
+                continue;
+            }
+            const std::size_t close = c == '{' ? pattern.find_first_of("{}", i + 1) : std::string_view::npos;
+            if (close == std::string_view::npos || pattern[close] != '}' || close == i + 1) {
+                text_.push_back(c);
+                ++i;
+                continue;
+            }
+            add_literal(literal_start);
+            const std::string_view placeholder = pattern.substr(i, close + 1 - i);
+            segments_.push_back({0, 0, slot_of(placeholder)});
+            literal_start = text_.size();
+            i = close + 1;
+        }
+        add_literal(literal_start);
+    }
+
+    /**
+     * @brief Returns the distinct placeholder names in order of first appearance; positional
+     *        arguments are matched to them in this order.
+     */
+    const std::vector<std::string>& names() const {
+        return names_;
+    }
+
+    /**
+     * @brief Renders the template into out, reusing its capacity. Placeholders without a value are
+     *        kept as they are, as a strutil::replace_all loop would leave them.
+     * @tparam Args - either a map from std::string to a value convertible to std::string_view, such as
+     *                std::unordered_map<std::string, std::string>, or a random access container of such
+     *                values used positionally.
+     * @param out - receives the rendered text; previous contents are overwritten.
+     * @param args - the values.
+     */
+    template<typename Args>
+    void render_into(std::string& out, const Args& args) const {
+        render_with(out, [&](std::size_t slot) -> std::string_view {
+            if constexpr (detail::is_map_like<Args>::value) {
+                const auto it = args.find(names_[slot]);
+                return it != args.end() ? std::string_view(it->second) : std::string_view(placeholders_[slot]);
+            } else {
+                return slot < std::size(args) ? std::string_view(args[slot]) : std::string_view(placeholders_[slot]);
+            }
+        });
+    }
+
+    /**
+     * @brief Renders the template into out from positional values, e.g. render_into(out, {"Ann", "3"}).
+     */
+    void render_into(std::string& out, std::initializer_list<std::string_view> args) const {
+        render_with(out, [&](std::size_t slot) {
+            return slot < args.size() ? args.begin()[slot] : std::string_view(placeholders_[slot]);
+        });
+    }
+
+    /**
+     * @brief Renders the template, see render_into.
+     * @return The rendered text.
+     */
+    template<typename Args>
+    std::string render(const Args& args) const {
+        std::string out;
+        render_into(out, args);
+        return out;
+    }
+
+    /**
+     * @brief Renders the template from positional values, e.g. render({"Ann", "3"}).
+     */
+    std::string render(std::initializer_list<std::string_view> args) const {
+        std::string out;
+        render_into(out, args);
+        return out;
+    }
+
+private:
+    static constexpr std::size_t LITERAL = std::string_view::npos;
+    static constexpr std::size_t INLINE_VALUES = 16;
+
+    /**
+     * @brief A run of literal text in text_ or, if slot is not LITERAL, the value of names_[slot].
+     */
+    struct segment {
+        std::size_t offset;
+        std::size_t size;
+        std::size_t slot;
+    };
+
+    void add_literal(std::size_t literal_start) {
+        if (text_.size() > literal_start) {
+            segments_.push_back({literal_start, text_.size() - literal_start, LITERAL});
+        }
+    }
+
+    std::size_t slot_of(std::string_view placeholder) {
+        const std::string_view name = placeholder.substr(1, placeholder.size() - 2);
+        const auto it = std::find(names_.begin(), names_.end(), name);
+        if (it != names_.end()) {
+            return static_cast<std::size_t>(it - names_.begin());
+        }
+        names_.emplace_back(name);
+        placeholders_.emplace_back(placeholder);
+        return names_.size() - 1;
+    }
+
+    template<typename Lookup>
+    void render_with(std::string& out, Lookup&& lookup) const {
+        std::string_view inline_values[INLINE_VALUES];
+        std::vector<std::string_view> heap_values;
+        std::string_view* values = inline_values;
+        if (names_.size() > INLINE_VALUES) {
+            heap_values.resize(names_.size());
+            values = heap_values.data();
+        }
+        for (std::size_t slot = 0; slot < names_.size(); ++slot) {
+            values[slot] = lookup(slot);
+        }
+
+        std::size_t size = 0;
+        for (const segment& seg : segments_) {
+            size += seg.slot == LITERAL ? seg.size : values[seg.slot].size();
+        }
+        out.resize(size);
+        char* dst = out.data();
+        for (const segment& seg : segments_) {
+            const std::string_view part = seg.slot == LITERAL ? std::string_view(text_).substr(seg.offset, seg.size) : values[seg.slot];
+            std::copy(part.begin(), part.end(), dst);
+            dst += part.size();
+        }
+    }
+
+    std::string text_;
+    std::vector<segment> segments_;
+    std::vector<std::string> names_;
+    std::vector<std::string> placeholders_;
+};
+
+} // namespace strutil
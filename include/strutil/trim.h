@@ -0,0 +1,96 @@
+/**
+******************************************************************************
+*
+*  @file       strutil/trim.h
+*  @brief      Whitespace trimming
+*
+******************************************************************************
+*/
+
+#pragma once
+
+#include "core.h"
+
+#include <algorithm>
+#include <cctype>
+#include <string>
+#include <string_view>
+
+namespace strutil {
+/**
+ * @brief Trims (in-place) white spaces from the left side of std::string.
+ *        Taken from: http://stackoverflow.com/questions/216823/whats-the-best-way-to-trim-stdstring.
+ * @param str - input std::string to remove white spaces from.
+ */
+inline void trim_left(std::string& str) {
+    str.erase(str.begin(), std::find_if(str.begin(), str.end(), [](int ch) { return !std::isspace(ch); }));
+}
+
+/**
+ * @brief Trims (in-place) white spaces from the right side of std::string.
+ *        Taken from: http://stackoverflow.com/questions/216823/whats-the-best-way-to-trim-stdstring.
+ * @param str - input std::string to remove white spaces from.
+ */
+inline void trim_right(std::string& str) {
+    str.erase(std::find_if(str.rbegin(), str.rend(), [](int ch) { return !std::isspace(ch); }).base(), str.end());
+}
+
+/**
+ * @brief Trims (in-place) white spaces from the both sides of std::string.
+ *        Taken from: http://stackoverflow.com/questions/216823/whats-the-best-way-to-trim-stdstring.
+ * @param str - input std::string to remove white spaces from.
+ */
+inline void trim(std::string& str) {
+    trim_left(str);
+    trim_right(str);
+}
+
+/**
+ * @brief Trims white spaces from the left side of std::string.
+ *        Taken from: http://stackoverflow.com/questions/216823/whats-the-best-way-to-trim-stdstring.
+ * @param str - input std::string to remove white spaces from.
+ * @return Copy of input str with trimmed white spaces.
+ */
+inline std::string trim_left_copy(std::string str) {
+    trim_left(str);
+    return str;
+}
+
+/**
+  * @brief Trims white spaces from the right side of std::string.
+  *        Taken from: http://stackoverflow.com/questions/216823/whats-the-best-way-to-trim-stdstring.
+  * @param str - input std::string to remove white spaces from.
+  * @return Copy of input str with trimmed white spaces.
+  */
+inline std::string trim_right_copy(std::string str) {
+    trim_right(str);
+    return str;
+}
+
+/**
+  * @brief Trims white spaces from the both sides of std::string.
+  *        Taken from: http://stackoverflow.com/questions/216823/whats-the-best-way-to-trim-stdstring.
+  * @param str - input std::string to remove white spaces from.
+  * @return Copy of input str with trimmed white spaces.
+  */
+inline std::string trim_copy(std::string str) {
+    trim(str);
+    return str;
+}
+
+/**
+ * @brief Returns a std::string_view with whitespace removed from both ends without copying.
+ * @param view input view to trim.
+ * @return View with leading and trailing whitespace removed.
+ */
+inline std::string_view trim_view(std::string_view view) {
+    while (!view.empty() && std::isspace(static_cast<unsigned char>(view.front()))) {
+        view.remove_prefix(1);
+    }
+    while (!view.empty() && std::isspace(static_cast<unsigned char>(view.back()))) {
+        view.remove_suffix(1);
+    }
+    return view;
+}
+
+} // namespace strutil
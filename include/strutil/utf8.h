@@ -0,0 +1,285 @@
+/**
+******************************************************************************
+*
+*  @file       strutil/utf8.h
+*  @brief      UTF-8 validation, length and truncation
+*
+******************************************************************************
+*/
+
+#pragma once
+
+#include "core.h"
+#include "dispatch.h"
+#include "encode.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+namespace strutil {
+namespace detail {
+/**
+ * @brief Returns the number of leading ASCII bytes of data, checking 8 bytes at a time.
+ */
+inline std::size_t ascii_prefix_length_scalar(const char* data, std::size_t size) {
+    std::size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        std::uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        if ((word & 0x8080808080808080ull) != 0) {
+            break;
+        }
+    }
+    while (i < size && static_cast<unsigned char>(data[i]) < 0x80) {
+        ++i;
+    }
+    return i;
+}
+
+#if defined(__SSE2__)
+/**
+ * @brief Returns the number of leading ASCII bytes of data, checking 16 bytes at a time.
+ */
+inline std::size_t ascii_prefix_length_sse2(const char* data, std::size_t size) {
+    std::size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        const auto mask = static_cast<unsigned>(
+            _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i))));
+        if (mask != 0) {
+            return i + count_trailing_zeros(mask);
+        }
+    }
+    while (i < size && static_cast<unsigned char>(data[i]) < 0x80) {
+        ++i;
+    }
+    return i;
+}
+#endif
+
+inline constexpr kernel_family<std::size_t (*)(const char*, std::size_t)> ASCII_PREFIX_KERNELS{
+    "ascii_prefix_length", {&ascii_prefix_length_scalar, STRUTIL_SSE2_KERNEL(&ascii_prefix_length_sse2), nullptr, nullptr}};
+inline const bool ASCII_PREFIX_KERNELS_REGISTERED = register_kernel(ASCII_PREFIX_KERNELS);
+
+/**
+ * @brief Returns the number of leading ASCII bytes of str, i.e. the offset of the first byte >= 0x80.
+ * @param str - input bytes.
+ * @return Length of the longest all-ASCII prefix of str.
+ */
+inline std::size_t ascii_prefix_length(std::string_view str) {
+    return ASCII_PREFIX_KERNELS.get()(str.data(), str.size());
+}
+
+/**
+ * @brief Returns the length of the well-formed UTF-8 sequence starting at str[pos] (see Unicode Table 3-7),
+ *        rejecting overlong encodings, surrogates and code points above U+10FFFF.
+ * @param str - input bytes.
+ * @param pos - offset of the first byte of the sequence; must be less than str.size().
+ * @return Sequence length in bytes (1-4), or 0 if the bytes at pos are not a well-formed sequence.
+ */
+inline std::size_t utf8_sequence_length(std::string_view str, std::size_t pos) {
+    const auto lead = static_cast<unsigned char>(str[pos]);
+    if (lead < 0x80) {
+        return 1;
+    }
+
+    std::size_t length;
+    unsigned char second_min = 0x80;
+    unsigned char second_max = 0xBF;
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        length = 2;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+        length = 3;
+        second_min = lead == 0xE0 ? 0xA0 : 0x80; // overlong
+        second_max = lead == 0xED ? 0x9F : 0xBF; // surrogates
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+        length = 4;
+        second_min = lead == 0xF0 ? 0x90 : 0x80; // overlong
+        second_max = lead == 0xF4 ? 0x8F : 0xBF; // above U+10FFFF
+    } else {
+        return 0;
+    }
+
+    if (str.size() - pos < length) {
+        return 0;
+    }
+    const auto second = static_cast<unsigned char>(str[pos + 1]);
+    if (second < second_min || second > second_max) {
+        return 0;
+    }
+    for (std::size_t i = 2; i < length; ++i) {
+        if ((static_cast<unsigned char>(str[pos + i]) & 0xC0) != 0x80) {
+            return 0;
+        }
+    }
+    return length;
+}
+
+/**
+ * @brief Returns the byte offset at which the code point with index n starts, counting every byte
+ *        that is not a continuation byte (10xxxxxx) as the start of a code point.
+ * @param str - UTF-8 input.
+ * @param n - index of the code point.
+ * @return Byte offset of code point n, or str.size() if str has n or fewer code points.
+ */
+inline std::size_t utf8_offset(std::string_view str, std::size_t n) {
+    std::size_t pos = 0;
+    while (pos < str.size()) {
+        // every ASCII byte is a whole code point, skip them in bulk; at most n of them are needed,
+        // so the scan stops there instead of running to the end of a long ASCII tail
+        const std::size_t ascii = ascii_prefix_length(str.substr(pos, n));
+        pos += ascii;
+        n -= ascii;
+        if (pos >= str.size()) {
+            break;
+        }
+        if ((static_cast<unsigned char>(str[pos]) & 0xC0) != 0x80) {
+            if (n == 0) {
+                return pos;
+            }
+            --n;
+        }
+        ++pos;
+    }
+    return str.size();
+}
+} // namespace detail
+
+/**
+ * @brief Finds the first byte of str that is not part of a well-formed UTF-8 sequence.
+ *        ASCII runs are skipped 16 bytes at a time, so ASCII-dominant text is validated at memory speed.
+ * @param str - input bytes.
+ * @return Offset of the first invalid sequence, or std::string_view::npos if str is valid UTF-8.
+ */
+inline std::size_t find_invalid_utf8(std::string_view str) {
+    std::size_t pos = 0;
+    while (true) {
+        pos += detail::ascii_prefix_length(str.substr(pos));
+        if (pos >= str.size()) {
+            return std::string_view::npos;
+        }
+        const std::size_t length = detail::utf8_sequence_length(str, pos);
+        if (length == 0) {
+            return pos;
+        }
+        pos += length;
+    }
+}
+
+/**
+ * @brief Checks if str is well-formed UTF-8.
+ * @param str - input bytes.
+ * @return True if str is valid UTF-8, false otherwise. Use strutil::find_invalid_utf8 to locate the error.
+ */
+inline bool is_valid_utf8(std::string_view str) {
+    return find_invalid_utf8(str) == std::string_view::npos;
+}
+
+namespace detail {
+/**
+ * @brief Counts the continuation bytes (10xxxxxx) of data one byte at a time.
+ */
+inline std::size_t count_continuation_bytes_scalar(const char* data, std::size_t size) {
+    std::size_t continuation_bytes = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+        continuation_bytes += (static_cast<unsigned char>(data[i]) & 0xC0) == 0x80;
+    }
+    return continuation_bytes;
+}
+
+#if defined(__SSE2__)
+/**
+ * @brief Counts the continuation bytes (10xxxxxx) of data 16 bytes at a time.
+ */
+inline std::size_t count_continuation_bytes_sse2(const char* data, std::size_t size) {
+    std::size_t continuation_bytes = 0;
+    std::size_t i = 0;
+    // continuation bytes are 0x80..0xBF, i.e. less than (signed) 0xC0
+    const __m128i limit = _mm_set1_epi8(static_cast<char>(0xC0));
+    for (; i + 16 <= size; i += 16) {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        continuation_bytes += popcount(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmplt_epi8(bytes, limit))));
+    }
+    return continuation_bytes + count_continuation_bytes_scalar(data + i, size - i);
+}
+#endif
+
+inline constexpr kernel_family<std::size_t (*)(const char*, std::size_t)> UTF8_LENGTH_KERNELS{
+    "utf8_length", {&count_continuation_bytes_scalar, STRUTIL_SSE2_KERNEL(&count_continuation_bytes_sse2), nullptr, nullptr}};
+inline const bool UTF8_LENGTH_KERNELS_REGISTERED = register_kernel(UTF8_LENGTH_KERNELS);
+} // namespace detail
+
+/**
+ * @brief Counts UTF-8 code points in str. Every byte that is not a continuation byte (10xxxxxx) counts
+ *        as one code point, so the result equals the code point count for valid UTF-8.
+ * @param str - UTF-8 input.
+ * @return Number of code points in str.
+ */
+inline std::size_t utf8_length(std::string_view str) {
+    return str.size() - detail::UTF8_LENGTH_KERNELS.get()(str.data(), str.size());
+}
+
+/**
+ * @brief Truncates the source string so that the result does not exceed max_output_string_length
+ *        UTF-8 code points, never cutting a multi-byte sequence. If truncation happens, the ellipsis
+ *        string is appended to the truncated substring, as in strutil::truncate.
+ * @param source_string - the UTF-8 input string that may need to be truncated.
+ * @param max_output_string_length - maximum length of the returned string in code points.
+ * @param ellipsis - string appended when truncation occurs.
+ * @return Truncated string with optional ellipsis.
+ */
+inline std::string truncate_utf8(std::string_view source_string,
+                                 size_t max_output_string_length = 100,
+                                 std::string_view ellipsis = "...") {
+    if (source_string.size() <= max_output_string_length
+        || detail::utf8_offset(source_string, max_output_string_length) == source_string.size()) {
+        return std::string(source_string);
+    }
+
+    const std::size_t ellipsis_length = utf8_length(ellipsis);
+    if (max_output_string_length <= ellipsis_length) {
+        return std::string(ellipsis.substr(0, detail::utf8_offset(ellipsis, max_output_string_length)));
+    }
+
+    const std::size_t cut = detail::utf8_offset(source_string, max_output_string_length - ellipsis_length);
+    std::string result;
+    result.reserve(cut + ellipsis.size());
+    result.append(source_string.substr(0, cut));
+    result.append(ellipsis);
+    return result;
+}
+
+/**
+ * @brief UTF-8 aware variant of strutil::preview: well-formed multi-byte sequences are kept as they are,
+ *        only control characters and bytes that are not valid UTF-8 are escaped. The result is then
+ *        truncated with strutil::truncate_utf8, so it is always valid UTF-8.
+ * @param source_string - the input string that may contain non-printable characters or invalid UTF-8.
+ * @param max_output_string_length - maximum length of the returned string in code points.
+ * @param ellipsis - string appended when truncation occurs.
+ * @return Sanitized and possibly truncated string.
+ */
+inline std::string preview_utf8(std::string_view source_string,
+                                size_t max_output_string_length = 100,
+                                std::string_view ellipsis = "...") {
+    std::string sanitized;
+    sanitized.reserve(source_string.size());
+
+    std::size_t pos = 0;
+    while (pos < source_string.size()) {
+        const auto ch = static_cast<unsigned char>(source_string[pos]);
+        const std::size_t length = ch < 0x80 ? 1 : detail::utf8_sequence_length(source_string, pos);
+        if (length > 1) {
+            sanitized.append(source_string.substr(pos, length));
+            pos += length;
+        } else {
+            detail::append_escaped(sanitized, ch);
+            ++pos;
+        }
+    }
+
+    return truncate_utf8(sanitized, max_output_string_length, ellipsis);
+}
+
+} // namespace strutil
@@ -0,0 +1,181 @@
+/**
+******************************************************************************
+*
+*  @file       strutil.cppm
+*  @brief      C++20 module interface: `import strutil;` exports the same public API as strutil.h.
+*              Build it with the STRUTIL_BUILD_MODULE CMake option (CMake 3.28+).
+*
+******************************************************************************
+*/
+
+module;
+
+#include "strutil.h"
+
+export module strutil;
+
+export namespace strutil {
+// batch.h
+using strutil::transform_all;
+
+// builder.h
+using strutil::string_builder;
+using strutil::to_string;
+
+// case.h
+using strutil::capitalize;
+using strutil::capitalize_utf8;
+using strutil::compare_ignore_case_utf8;
+using strutil::fold_case_utf8;
+using strutil::to_lower;
+using strutil::to_lower_utf8;
+using strutil::to_upper;
+using strutil::to_upper_utf8;
+
+// compare.h
+using strutil::compare_ignore_case;
+using strutil::contains;
+using strutil::contains_ignore_case;
+using strutil::ends_with;
+using strutil::ends_with_ignore_case;
+using strutil::find_ignore_case;
+using strutil::is_alphanumeric;
+using strutil::starts_with;
+using strutil::starts_with_ignore_case;
+
+// dispatch.h
+using strutil::active_isa;
+using strutil::detected_isa;
+using strutil::dispatch_report;
+using strutil::isa_level;
+using strutil::isa_name;
+using strutil::kernel_dispatch;
+using strutil::set_isa;
+
+// encode.h
+using strutil::base64_alphabet;
+using strutil::base64_decoded_size;
+using strutil::base64_encoded_size;
+using strutil::escape_c;
+using strutil::escape_json;
+using strutil::from_base64;
+using strutil::from_base64_into;
+using strutil::to_base64;
+using strutil::to_base64_into;
+using strutil::to_binary_string;
+using strutil::to_hex_string;
+using strutil::unescape_c;
+
+// hash.h
+using strutil::hash;
+using strutil::hasher;
+
+// intern.h
+using strutil::intern_pool;
+using strutil::sharded_intern_pool;
+using strutil::split_interned;
+
+// layout.h
+using strutil::center;
+using strutil::center_into;
+using strutil::pad_left;
+using strutil::pad_left_into;
+using strutil::pad_right;
+using strutil::pad_right_into;
+using strutil::wrap;
+using strutil::wrap_into;
+using strutil::wrap_options;
+
+// match.h
+using strutil::fuzzy_matcher;
+using strutil::glob_match;
+using strutil::glob_pattern;
+using strutil::glob_set;
+using strutil::levenshtein_distance;
+using strutil::within_distance;
+
+// parse.h
+using strutil::csv_reader;
+using strutil::kv_index;
+using strutil::kv_pair;
+using strutil::parse_kv;
+using strutil::parse_kv_into;
+using strutil::parse_numbers_into;
+using strutil::parse_query;
+using strutil::percent_decode;
+using strutil::split_numbers;
+
+// random.h
+using strutil::random_alphanumeric_string;
+using strutil::random_lowercase_string;
+
+// sort.h
+using strutil::natural_compare;
+using strutil::reverse_copy;
+using strutil::reverse_inplace;
+using strutil::sort_ignore_case;
+using strutil::sort_natural;
+using strutil::sort_views;
+using strutil::sorting_ascending;
+using strutil::sorting_descending;
+
+// split.h
+using strutil::partition;
+using strutil::partition_result;
+using strutil::rpartition;
+using strutil::rsplit_once;
+using strutil::split;
+using strutil::split_any;
+using strutil::split_any_into;
+using strutil::split_into;
+using strutil::split_lines;
+using strutil::split_lines_clean;
+using strutil::split_lines_into;
+using strutil::split_once;
+using strutil::split_options;
+using strutil::split_views;
+
+// stats.h
+using strutil::function_stats;
+using strutil::set_stats_sampling;
+using strutil::stats_enabled;
+using strutil::stats_snapshot;
+
+// text.h
+using strutil::drop_empty;
+using strutil::drop_empty_copy;
+using strutil::join;
+using strutil::join_objects;
+using strutil::preview;
+using strutil::repeat;
+using strutil::replace_all;
+using strutil::replace_first;
+using strutil::replace_last;
+using strutil::template_string;
+using strutil::truncate;
+
+// trim.h
+using strutil::trim;
+using strutil::trim_copy;
+using strutil::trim_left;
+using strutil::trim_left_copy;
+using strutil::trim_right;
+using strutil::trim_right_copy;
+using strutil::trim_view;
+
+// utf8.h
+using strutil::find_invalid_utf8;
+using strutil::is_valid_utf8;
+using strutil::preview_utf8;
+using strutil::truncate_utf8;
+using strutil::utf8_length;
+} // namespace strutil
+
+export namespace strutil::ops {
+// batch.h
+using strutil::ops::replace_all;
+using strutil::ops::to_lower;
+using strutil::ops::to_upper;
+using strutil::ops::trim;
+using strutil::ops::truncate;
+} // namespace strutil::ops
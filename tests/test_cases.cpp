@@ -4,7 +4,13 @@
 
 #include <gtest/gtest.h>
 #include <include/strutil.h>
+#include <map>
+#include <memory_resource>
 #include <ostream>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 
 /*
 * Comparison tests
@@ -98,6 +104,47 @@ TEST(Compare, contains_char) {
     EXPECT_FALSE(strutil::contains("", 'z'));
 }
 
+TEST(Compare, find_ignore_case) {
+    EXPECT_EQ(strutil::find_ignore_case("DiffuseTexture_m", "TEXTURE"), 7U);
+    EXPECT_EQ(strutil::find_ignore_case("DiffuseTexture_m", "texturez"), std::string_view::npos);
+    EXPECT_EQ(strutil::find_ignore_case("abc", ""), 0U);
+    EXPECT_EQ(strutil::find_ignore_case("abc", "", 3), 3U);
+    EXPECT_EQ(strutil::find_ignore_case("abc", "", 4), std::string_view::npos);
+    EXPECT_EQ(strutil::find_ignore_case("", "a"), std::string_view::npos);
+    EXPECT_EQ(strutil::find_ignore_case("aAaA", "AA", 1), 1U);
+    EXPECT_EQ(strutil::find_ignore_case("[@`{", "[@`{"), 0U); // neighbours of the letter ranges do not fold
+    EXPECT_EQ(strutil::find_ignore_case("{{{{", "[["), std::string_view::npos);
+
+    // matches inside, across and after 16-byte blocks agree with the allocating equivalent
+    const std::string haystack = "The Quick Brown Fox Jumps Over The Lazy Dog, the QUICK brown fox again. END";
+    for (std::size_t start = 0; start < haystack.size(); start += 3) {
+        for (std::size_t length = 1; start + length <= haystack.size(); length += 5) {
+            const std::string needle = strutil::to_upper(haystack.substr(start, length));
+            EXPECT_EQ(strutil::find_ignore_case(haystack, needle), strutil::to_lower(haystack).find(strutil::to_lower(needle)))
+                << needle;
+        }
+    }
+}
+
+TEST(Compare, contains_ignore_case) {
+    EXPECT_TRUE(strutil::contains_ignore_case("DiffuseTexture_m", "FUSE"));
+    EXPECT_TRUE(strutil::contains_ignore_case("", ""));
+    EXPECT_FALSE(strutil::contains_ignore_case("DiffuseTexture_m", "fuser"));
+    EXPECT_FALSE(strutil::contains_ignore_case("", "abc"));
+}
+
+TEST(Compare, starts_ends_with_ignore_case) {
+    EXPECT_TRUE(strutil::starts_with_ignore_case("m_DiffuseTexture", "M_diff"));
+    EXPECT_TRUE(strutil::starts_with_ignore_case("abc", ""));
+    EXPECT_FALSE(strutil::starts_with_ignore_case("abc", "ABCD"));
+    EXPECT_FALSE(strutil::starts_with_ignore_case("p_DiffuseTexture", "m_"));
+
+    EXPECT_TRUE(strutil::ends_with_ignore_case("DiffuseTexture_m", "TEXTURE_M"));
+    EXPECT_TRUE(strutil::ends_with_ignore_case("", ""));
+    EXPECT_FALSE(strutil::ends_with_ignore_case("abc", "_ABC"));
+    EXPECT_FALSE(strutil::ends_with_ignore_case("DiffuseTexture_p", "_m"));
+}
+
 /*
  * Parsing tests
  */
@@ -182,6 +229,112 @@ TEST(StringPreview, handles_null_character) {
 TEST(StringPreview, truncates_after_sanitizing) {
     std::string input = "abcdef";
     EXPECT_EQ("ab...", strutil::preview(input, 5));
+}
+
+/*
+ * UTF-8 tests
+ */
+
+TEST(Utf8, is_valid_utf8) {
+    EXPECT_TRUE(strutil::is_valid_utf8(""));
+    EXPECT_TRUE(strutil::is_valid_utf8("plain ascii text that is longer than one sixteen byte block"));
+    EXPECT_TRUE(strutil::is_valid_utf8("Gr\xC3\xBC\xC3\x9F Gott, \xD0\x9F\xD1\x80\xD0\xB8\xD0\xB2\xD0\xB5\xD1\x82 \xE2\x82\xAC \xF0\x9F\x98\x80"));
+
+    const std::vector<std::pair<std::string, std::size_t>> invalid = {
+        {"\x80", 0},                                       // lone continuation byte
+        {"abc\xC3", 3},                                    // truncated sequence
+        {"ab\xC0\xAF", 2},                                // overlong '/'
+        {"\xE0\x80\xAF", 0},                              // overlong 3-byte
+        {"\xED\xA0\x80", 0},                              // surrogate
+        {"\xF4\x90\x80\x80", 0},                          // above U+10FFFF
+        {"\xFF", 0},
+        {"0123456789abcdef0123456789\xC3\x28", 26},        // bad continuation after a SIMD block
+    };
+    for (const auto& t : invalid) {
+        EXPECT_FALSE(strutil::is_valid_utf8(t.first)) << t.second;
+        EXPECT_EQ(strutil::find_invalid_utf8(t.first), t.second);
+    }
+    EXPECT_EQ(strutil::find_invalid_utf8("\xC3\xBC ok"), std::string_view::npos);
+}
+
+TEST(Utf8, utf8_length) {
+    EXPECT_EQ(strutil::utf8_length(""), 0U);
+    EXPECT_EQ(strutil::utf8_length("hello"), 5U);
+    EXPECT_EQ(strutil::utf8_length("\xD0\x9F\xD1\x80\xD0\xB8\xD0\xB2\xD0\xB5\xD1\x82"), 6U);
+    // euro sign and emoji right after a full 16-byte block, then ASCII again
+    EXPECT_EQ(strutil::utf8_length("0123456789abcdef\xE2\x82\xAC\xF0\x9F\x98\x80xyz\xC3\xBC" "0123456789"), 32U);
+}
+
+TEST(Utf8, truncate_utf8) {
+    const std::string privet = "\xD0\x9F\xD1\x80\xD0\xB8\xD0\xB2\xD0\xB5\xD1\x82"; // 6 code points, 12 bytes
+    EXPECT_EQ(strutil::truncate_utf8(privet, 6), privet);
+    EXPECT_EQ(strutil::truncate_utf8(privet, 100), privet);
+    EXPECT_EQ(strutil::truncate_utf8(privet, 5), "\xD0\x9F\xD1\x80...");
+    EXPECT_EQ(strutil::truncate_utf8(privet, 3, "\xE2\x80\xA6"), "\xD0\x9F\xD1\x80\xE2\x80\xA6");
+    EXPECT_EQ(strutil::truncate_utf8(privet, 2), "..");
+    EXPECT_EQ(strutil::truncate_utf8(privet, 0), "");
+
+    // ASCII behaves exactly like truncate
+    EXPECT_EQ(strutil::truncate_utf8("hello world", 5), strutil::truncate("hello world", 5));
+    EXPECT_EQ(strutil::truncate_utf8("hello world", 2, "~"), strutil::truncate("hello world", 2, "~"));
+    EXPECT_TRUE(strutil::is_valid_utf8(strutil::truncate_utf8("a\xC3\xBC\xC3\xBC\xC3\xBC\xC3\xBC", 4)));
+}
+
+TEST(Utf8, preview_utf8) {
+    EXPECT_EQ(strutil::preview_utf8("Gr\xC3\xBC\xC3\x9F\n"), "Gr\xC3\xBC\xC3\x9F\\n");
+    EXPECT_EQ(strutil::preview_utf8("bad\xC3(\xFF"), "bad\\xC3(\\xFF");
+    EXPECT_EQ(strutil::preview_utf8("\xC3\xBC\xC3\xBC\xC3\xBC\xC3\xBC\xC3\xBC", 4), "\xC3\xBC...");
+    EXPECT_EQ(strutil::preview_utf8("Line1\nLine2\r\n\tEnd"), strutil::preview("Line1\nLine2\r\n\tEnd"));
+}
+
+TEST(Utf8, to_lower_upper_utf8) {
+    // German and Cyrillic names
+    EXPECT_EQ(strutil::to_lower_utf8("J\xC3\x9CRGEN \xC3\x96ZT\xC3\x9CRK"), "j\xC3\xBCrgen \xC3\xB6zt\xC3\xBCrk");
+    EXPECT_EQ(strutil::to_upper_utf8("j\xC3\xBCrgen"), "J\xC3\x9CRGEN");
+    EXPECT_EQ(strutil::to_lower_utf8("\xD0\x9F\xD0\xA0\xD0\x98\xD0\x92\xD0\x95\xD0\xA2"),
+              "\xD0\xBF\xD1\x80\xD0\xB8\xD0\xB2\xD0\xB5\xD1\x82");
+    EXPECT_EQ(strutil::to_upper_utf8("\xD0\xBF\xD1\x80\xD0\xB8\xD0\xB2\xD0\xB5\xD1\x82"),
+              "\xD0\x9F\xD0\xA0\xD0\x98\xD0\x92\xD0\x95\xD0\xA2");
+
+    // ASCII matches the byte-wise functions, including blocks longer than 16 bytes
+    const std::string ascii = "HeLlo StRUTIL, this Is A Longer ASCII Line @[`{";
+    EXPECT_EQ(strutil::to_lower_utf8(ascii), strutil::to_lower(ascii));
+    EXPECT_EQ(strutil::to_upper_utf8(ascii), strutil::to_upper(ascii));
+
+    // mappings that change the encoded length, supplementary planes and invalid bytes
+    EXPECT_EQ(strutil::to_lower_utf8("\xC8\xBA"), "\xE2\xB1\xA5");             // U+023A -> U+2C65
+    EXPECT_EQ(strutil::to_lower_utf8("\xF0\x90\x90\x80"), "\xF0\x90\x90\xA8"); // Deseret U+10400 -> U+10428
+    EXPECT_EQ(strutil::to_upper_utf8("a\xFF" "b"), "A\xFF" "B");
+    EXPECT_EQ(strutil::to_upper_utf8("\xC3\x9F"), "\xC3\x9F"); // no single code point uppercase for sharp s
+    // simple mappings of code points whose full mapping expands
+    EXPECT_EQ(strutil::to_lower_utf8("\xC4\xB0"), "i");                       // U+0130 -> U+0069
+    EXPECT_EQ(strutil::to_upper_utf8("\xE1\xBE\xB3"), "\xE1\xBE\xBC");         // U+1FB3 -> U+1FBC
+    EXPECT_EQ(strutil::to_upper_utf8("\xE1\xBE\x80"), "\xE1\xBE\x88");         // U+1F80 -> U+1F88
+    EXPECT_EQ(strutil::fold_case_utf8("\xC4\xB0"), "\xC4\xB0");                // no simple case folding
+}
+
+TEST(Utf8, capitalize_utf8) {
+    EXPECT_EQ(strutil::capitalize_utf8("\xC3\xBC" "ber"), "\xC3\x9C" "ber");
+    EXPECT_EQ(strutil::capitalize_utf8("heLlo"), strutil::capitalize("heLlo"));
+    EXPECT_EQ(strutil::capitalize_utf8(""), "");
+}
+
+TEST(Utf8, compare_ignore_case_utf8) {
+    EXPECT_TRUE(strutil::compare_ignore_case_utf8("", ""));
+    EXPECT_TRUE(strutil::compare_ignore_case_utf8("PoKeMoN!", "pokemon!"));
+    EXPECT_FALSE(strutil::compare_ignore_case_utf8("PoKeMoN!", "POKEMON"));
+    EXPECT_TRUE(strutil::compare_ignore_case_utf8("Stra\xC3\x9F" "e", "STRA\xE1\xBA\x9E" "E")); // sharp s vs capital sharp s
+    EXPECT_TRUE(strutil::compare_ignore_case_utf8("\xD0\x9F\xD1\x80\xD0\xB8\xD0\xB2\xD0\xB5\xD1\x82",
+                                                  "\xD0\xBF\xD0\xA0\xD0\x98\xD0\xB2\xD0\x95\xD1\x82"));
+    EXPECT_TRUE(strutil::compare_ignore_case_utf8("\xCF\x83\xCF\x82", "\xCE\xA3\xCE\xA3")); // final sigma folds to sigma
+    EXPECT_TRUE(strutil::compare_ignore_case_utf8("\xE2\x84\xAA", "k"));                     // Kelvin sign, different lengths
+    EXPECT_FALSE(strutil::compare_ignore_case_utf8("\xC4\xB1", "i"));                         // dotless i has no simple folding
+    EXPECT_FALSE(strutil::compare_ignore_case_utf8("abc\xFF", "ABC\xFE"));
+    EXPECT_TRUE(strutil::compare_ignore_case_utf8("abc\xFF", "ABC\xFF"));
+    EXPECT_TRUE(strutil::compare_ignore_case_utf8("A Long ASCII Prefix Here \xC3\x96", "a long ascii prefix here \xC3\xB6"));
+    EXPECT_FALSE(strutil::compare_ignore_case_utf8("A Long ASCII Prefix Here!", "a long ascii prefix here?"));
+    EXPECT_FALSE(strutil::compare_ignore_case_utf8("abc", "abcd"));
+    EXPECT_EQ(strutil::fold_case_utf8("Stra\xE1\xBA\x9E" "E"), "stra\xC3\x9F" "e");
 }
 
 /*
@@ -405,6 +558,381 @@ TEST(Splitting, drop_empty_copy) {
     ASSERT_EQ(res[2], "t4");
 }
 
+TEST(Splitting, split_pmr) {
+    // Everything must fit in the arena: the null upstream throws on any fallback allocation
+    char buffer[4096];
+    std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+
+    auto res = strutil::split("a fairly long first token;b;;c", ';', &arena);
+    ASSERT_EQ(res.size(), 4);
+    EXPECT_EQ(res[0], "a fairly long first token");
+    EXPECT_EQ(res[2], "");
+    EXPECT_EQ(res[0].get_allocator().resource(), &arena);
+
+    auto res_str = strutil::split("abc>=>=a rather long token that does not fit SSO", ">=", &arena);
+    ASSERT_EQ(res_str.size(), 3);
+    EXPECT_EQ(res_str[2], "a rather long token that does not fit SSO");
+
+    auto res_any = strutil::split_any("abc,def|ghi", ",|", &arena);
+    ASSERT_EQ(res_any.size(), 3);
+    EXPECT_EQ(res_any[1], "def");
+
+    auto lines = strutil::split_lines("one\r\ntwo\n", &arena);
+    ASSERT_EQ(lines.size(), 3);
+    EXPECT_EQ(lines[0], "one");
+    EXPECT_EQ(lines[2], "");
+
+    EXPECT_EQ(strutil::join(res, "|", &arena), "a fairly long first token|b||c");
+    EXPECT_EQ(strutil::join(std::vector<int>{1, 2, 3}, "|", &arena), "1|2|3");
+    EXPECT_EQ(strutil::join(std::vector<std::string>{}, "|", &arena), "");
+}
+
+TEST(Splitting, split_into_reuses_capacity) {
+    std::vector<std::string> out;
+    strutil::split_into("first long token that needs heap;second long token that needs heap", ';', out);
+    ASSERT_EQ(out.size(), 2);
+    const char* first_buffer = out[0].data();
+    const auto vector_buffer = out.data();
+
+    // Same or smaller token count and lengths => no reallocation of the vector or the strings
+    strutil::split_into("short;tokens", ';', out);
+    EXPECT_EQ(out, (std::vector<std::string>{"short", "tokens"}));
+    EXPECT_EQ(out[0].data(), first_buffer);
+    EXPECT_EQ(out.data(), vector_buffer);
+
+    strutil::split_into("single", ';', out);
+    EXPECT_EQ(out, (std::vector<std::string>{"single"}));
+
+    strutil::split_into(";a;;b;", ';', out);
+    EXPECT_EQ(out, strutil::split(";a;;b;", ';'));
+
+    strutil::split_into("abc>=>=def", ">=", out);
+    EXPECT_EQ(out, (std::vector<std::string>{"abc", "", "def"}));
+
+    strutil::split_any_into("abc,def|ghi jkl", ",| ", out);
+    EXPECT_EQ(out, (std::vector<std::string>{"abc", "def", "ghi", "jkl"}));
+
+    strutil::split_lines_into("\r\n4abc\n\r\ndef\nghi\n", out);
+    EXPECT_EQ(out, (std::vector<std::string>{"", "4abc", "", "def", "ghi", ""}));
+
+    strutil::split_into("", ';', out);
+    EXPECT_EQ(out, (std::vector<std::string>{""}));
+}
+
+TEST(Splitting, split_options) {
+    using views = std::vector<std::string_view>;
+    strutil::split_options options;
+    EXPECT_EQ(strutil::split_views("a,,b,", ',', options), (views{"a", "", "b", ""}));
+    EXPECT_EQ(strutil::split_views("", ','), (views{""}));
+
+    options.skip_empty = true;
+    EXPECT_EQ(strutil::split_views("a,,b,", ',', options), (views{"a", "b"}));
+    EXPECT_EQ(strutil::split_views("", ',', options), views{});
+    EXPECT_EQ(strutil::split_views(" a , ,b ", ',', options), (views{" a ", " ", "b "}));
+
+    options.trim_tokens = true;
+    EXPECT_EQ(strutil::split_views(" a , ,b ", ',', options), (views{"a", "b"}));
+    EXPECT_EQ(strutil::split(" a :: ::b ", "::", options), (std::vector<std::string>{"a", "b"}));
+
+    strutil::split_options limited;
+    limited.max_splits = 1;
+    EXPECT_EQ(strutil::split_views("k=v=w", '=', limited), (views{"k", "v=w"}));
+    limited.from_right = true;
+    EXPECT_EQ(strutil::split_views("k=v=w", '=', limited), (views{"k=v", "w"}));
+    EXPECT_EQ(strutil::split("/usr/local/bin", "/", limited), (std::vector<std::string>{"/usr/local", "bin"}));
+    limited.max_splits = 0;
+    EXPECT_EQ(strutil::split_views("k=v=w", '=', limited), (views{"k=v=w"}));
+
+    strutil::split_options from_right;
+    from_right.from_right = true;
+    from_right.skip_empty = true;
+    EXPECT_EQ(strutil::split_views("a--b----c--", "--", from_right), (views{"a", "b", "c"}));
+    EXPECT_EQ(strutil::split_views("abc", "", from_right), (views{"abc"}));
+
+    // without options the fused split matches split
+    for (const std::string_view input : {"", ",", "a", "a,b", ",a,,b,"}) {
+        const std::vector<std::string> tokens = strutil::split(input, ',', strutil::split_options());
+        EXPECT_EQ(tokens, strutil::split(input, ',')) << input;
+        strutil::split_options reversed;
+        reversed.from_right = true;
+        EXPECT_EQ(strutil::split(input, ",", reversed), tokens) << input;
+    }
+}
+
+TEST(Splitting, partition) {
+    static_assert(strutil::partition("key:value", ':').after == "value");
+    static_assert(strutil::rpartition("a/b/c", "/").before == "a/b");
+
+    const auto [before, delim, after] = strutil::partition("host:port:extra", ':');
+    EXPECT_EQ(before, "host");
+    EXPECT_EQ(delim, ":");
+    EXPECT_EQ(after, "port:extra");
+
+    const strutil::partition_result last = strutil::rpartition("a::b::c", "::");
+    EXPECT_EQ(last.before, "a::b");
+    EXPECT_EQ(last.delim, "::");
+    EXPECT_EQ(last.after, "c");
+
+    const strutil::partition_result missing = strutil::partition("abc", ',');
+    EXPECT_EQ(missing.before, "abc");
+    EXPECT_TRUE(missing.delim.empty() && missing.after.empty());
+    const strutil::partition_result rmissing = strutil::rpartition("abc", "");
+    EXPECT_TRUE(rmissing.before.empty() && rmissing.delim.empty());
+    EXPECT_EQ(rmissing.after, "abc");
+}
+
+TEST(Splitting, split_once) {
+    static_assert(strutil::split_once("k=v", '=')->first == "k");
+    static_assert(!strutil::rsplit_once("kv", "=").has_value());
+
+    using parts = std::pair<std::string_view, std::string_view>;
+    EXPECT_EQ(strutil::split_once("k=v=w", '='), (parts{"k", "v=w"}));
+    EXPECT_EQ(strutil::rsplit_once("k=v=w", '='), (parts{"k=v", "w"}));
+    EXPECT_EQ(strutil::split_once("a->b->c", "->"), (parts{"a", "b->c"}));
+    EXPECT_EQ(strutil::rsplit_once("a->b->c", "->"), (parts{"a->b", "c"}));
+    EXPECT_EQ(strutil::split_once("=", '='), (parts{"", ""}));
+    EXPECT_EQ(strutil::split_once("abc", ','), std::nullopt);
+    EXPECT_EQ(strutil::split_once("abc", ""), std::nullopt);
+}
+
+TEST(Splitting, csv_reader) {
+    const std::string input =
+        "name,comment,count\r\n"
+        "plain,\"quoted, with delimiter\",1\n"
+        "\"multi\nline\",\"say \"\"hi\"\"\",\n"
+        "\n"
+        "last,\"\",3";
+    strutil::csv_reader reader(input);
+    std::vector<std::string_view> fields;
+
+    ASSERT_TRUE(reader.next_record(fields));
+    EXPECT_EQ(fields, (std::vector<std::string_view>{"name", "comment", "count"}));
+
+    ASSERT_TRUE(reader.next_record(fields));
+    EXPECT_EQ(fields, (std::vector<std::string_view>{"plain", "quoted, with delimiter", "1"}));
+    // fields without escaped quotes point into the input
+    EXPECT_GE(fields[1].data(), input.data());
+    EXPECT_LT(fields[1].data(), input.data() + input.size());
+
+    ASSERT_TRUE(reader.next_record(fields));
+    EXPECT_EQ(fields, (std::vector<std::string_view>{"multi\nline", "say \"hi\"", ""}));
+
+    ASSERT_TRUE(reader.next_record(fields));
+    EXPECT_EQ(fields, (std::vector<std::string_view>{""}));
+
+    ASSERT_TRUE(reader.next_record(fields));
+    EXPECT_EQ(fields, (std::vector<std::string_view>{"last", "", "3"}));
+
+    EXPECT_FALSE(reader.next_record(fields));
+    EXPECT_FALSE(strutil::csv_reader("").next_record(fields));
+
+    // a final CR without LF is a line terminator too
+    strutil::csv_reader cr_reader("x\r\n\"y\",z\r");
+    ASSERT_TRUE(cr_reader.next_record(fields));
+    EXPECT_EQ(fields, (std::vector<std::string_view>{"x"}));
+    ASSERT_TRUE(cr_reader.next_record(fields));
+    EXPECT_EQ(fields, (std::vector<std::string_view>{"y", "z"}));
+    EXPECT_FALSE(cr_reader.next_record(fields));
+}
+
+TEST(Splitting, csv_reader_stream) {
+    // records spanning several 64-byte blocks and quoted regions crossing block boundaries
+    std::string input;
+    std::vector<std::vector<std::string>> expected;
+    for (int i = 0; i < 2000; ++i) {
+        const std::string quoted = strutil::repeat("x,\n", static_cast<unsigned>(i % 50));
+        input += std::to_string(i) + ";\"" + quoted + "\";" + strutil::repeat('y', static_cast<unsigned>(i % 70)) + "\n";
+        expected.push_back({std::to_string(i), quoted, std::string(static_cast<std::size_t>(i % 70), 'y')});
+    }
+
+    std::istringstream stream(input);
+    strutil::csv_reader stream_reader(stream, ';');
+    strutil::csv_reader buffer_reader(input, ';');
+    std::vector<std::string_view> fields;
+    for (const auto& record : expected) {
+        ASSERT_TRUE(stream_reader.next_record(fields));
+        ASSERT_EQ(fields.size(), 3U);
+        EXPECT_EQ(std::vector<std::string>(fields.begin(), fields.end()), record);
+        ASSERT_TRUE(buffer_reader.next_record(fields));
+        EXPECT_EQ(std::vector<std::string>(fields.begin(), fields.end()), record);
+    }
+    EXPECT_FALSE(stream_reader.next_record(fields));
+    EXPECT_FALSE(buffer_reader.next_record(fields));
+}
+
+TEST(Splitting, parse_kv) {
+    using pairs = std::vector<strutil::kv_pair>;
+    const std::string config = "k1=v1;k2=v2;;flag;k3=a=b;";
+    const auto res = strutil::parse_kv(config);
+    EXPECT_EQ(res, (pairs{{"k1", "v1"}, {"k2", "v2"}, {"flag", ""}, {"k3", "a=b"}}));
+    EXPECT_EQ(res[0].first.data(), config.data());
+
+    EXPECT_EQ(strutil::parse_kv(" a = 1 ,\tb=2 , ", ',', '=', true), (pairs{{"a", "1"}, {"b", "2"}}));
+    EXPECT_EQ(strutil::parse_kv(" a = 1 ", ',', '='), (pairs{{" a ", " 1 "}}));
+    EXPECT_TRUE(strutil::parse_kv("").empty());
+
+    pairs out{{"stale", "entry"}};
+    strutil::parse_kv_into("x:1|y:2", out, '|', ':');
+    EXPECT_EQ(out, (pairs{{"x", "1"}, {"y", "2"}}));
+}
+
+TEST(Splitting, parse_query) {
+    using pairs = std::vector<strutil::kv_pair>;
+    std::string scratch;
+    const std::string query = "a=1&name=John+Doe&q=50%25%20off&bad=%zz%4&empty=";
+    const auto res = strutil::parse_query(query, scratch);
+    EXPECT_EQ(res, (pairs{{"a", "1"}, {"name", "John Doe"}, {"q", "50% off"}, {"bad", "%zz%4"}, {"empty", ""}}));
+    EXPECT_EQ(res[0].second.data(), query.data() + 2); // no escapes => points into the query
+
+    EXPECT_EQ(strutil::percent_decode("a%2Fb+c"), "a/b+c");
+    EXPECT_EQ(strutil::percent_decode("a%2fb+c", true), "a/b c");
+}
+
+TEST(Splitting, kv_index) {
+    std::string config;
+    for (int i = 0; i < 100; ++i) {
+        config += "key" + std::to_string(i) + "=value" + std::to_string(i) + ";";
+    }
+    config += "key7=duplicate";
+
+    const strutil::kv_index index(strutil::parse_kv(config));
+    EXPECT_EQ(index.pairs().size(), 101U);
+    for (int i = 0; i < 100; ++i) {
+        const auto* value = index.find("key" + std::to_string(i));
+        ASSERT_NE(value, nullptr);
+        EXPECT_EQ(*value, "value" + std::to_string(i));
+    }
+    EXPECT_EQ(index.get("key7"), "value7"); // first occurrence wins
+    EXPECT_FALSE(index.contains("key100"));
+    EXPECT_EQ(index.get("missing", "default"), "default");
+
+    const strutil::kv_index empty(strutil::parse_kv(""));
+    EXPECT_EQ(empty.find("a"), nullptr);
+}
+
+TEST(Splitting, split_numbers) {
+    EXPECT_EQ(strutil::split_numbers<int>("1,2,3", ','), (std::vector<int>{1, 2, 3}));
+    EXPECT_EQ(strutil::split_numbers<int>(" -1 ; 20 ;300", ';'), (std::vector<int>{-1, 20, 300}));
+    EXPECT_EQ(strutil::split_numbers<long long>("1234567890123456,-1234567890123456,12345678901234567", ','),
+              (std::vector<long long>{1234567890123456LL, -1234567890123456LL, 12345678901234567LL}));
+    EXPECT_EQ(strutil::split_numbers<std::uint8_t>("0,255", ','), (std::vector<std::uint8_t>{0, 255}));
+    EXPECT_EQ(strutil::split_numbers<double>("1.5,-2e3,0.25", ','), (std::vector<double>{1.5, -2000.0, 0.25}));
+    EXPECT_TRUE(strutil::split_numbers<int>("", ',').empty());
+
+    std::size_t error_offset = 0;
+    EXPECT_EQ(strutil::split_numbers<int>("1,2", ',', &error_offset), (std::vector<int>{1, 2}));
+    EXPECT_EQ(error_offset, std::string_view::npos);
+
+    EXPECT_EQ(strutil::split_numbers<int>("1,2x,3", ',', &error_offset), (std::vector<int>{1}));
+    EXPECT_EQ(error_offset, 2U);
+    strutil::split_numbers<int>("1,,3", ',', &error_offset);
+    EXPECT_EQ(error_offset, 2U);
+    strutil::split_numbers<std::uint8_t>("1,256", ',', &error_offset);
+    EXPECT_EQ(error_offset, 2U);
+    strutil::split_numbers<unsigned>("7,-1", ',', &error_offset);
+    EXPECT_EQ(error_offset, 2U);
+    strutil::split_numbers<int>("12345678,1234567a", ',', &error_offset);
+    EXPECT_EQ(error_offset, 9U);
+    strutil::split_numbers<int>("99999999999", ',', &error_offset);
+    EXPECT_EQ(error_offset, 0U);
+}
+
+TEST(Splitting, parse_numbers_into) {
+    std::vector<std::int64_t> out{42};
+    EXPECT_EQ(strutil::parse_numbers_into("-9223372036854775808|9223372036854775807|00000012", '|', out),
+              std::string_view::npos);
+    EXPECT_EQ(out, (std::vector<std::int64_t>{std::numeric_limits<std::int64_t>::min(),
+                                              std::numeric_limits<std::int64_t>::max(), 12}));
+
+    std::vector<float> floats;
+    EXPECT_EQ(strutil::parse_numbers_into("1.5 2.5 nope", ' ', floats), 8U);
+    EXPECT_EQ(floats, (std::vector<float>{1.5f, 2.5f}));
+}
+
+TEST(Splitting, intern_pool) {
+    strutil::intern_pool pool(64);
+    const auto a = pool.intern("host-a");
+    const auto b = pool.intern("host-b");
+    const std::string long_token(200, 'x');
+    const auto c = pool.intern(long_token);
+    EXPECT_NE(a, b);
+    EXPECT_EQ(pool.intern(std::string("host-a")), a);
+    EXPECT_EQ(pool.intern(""), pool.intern(""));
+    EXPECT_EQ(pool.view(c), long_token);
+
+    // views stay valid while the pool grows
+    const std::string_view a_view = pool.view(a);
+    for (int i = 0; i < 10000; ++i) {
+        pool.intern("token" + std::to_string(i));
+    }
+    EXPECT_EQ(pool.size(), 10004U);
+    EXPECT_EQ(pool.view(a).data(), a_view.data());
+    EXPECT_EQ(pool.view(pool.intern("token1234")), "token1234");
+
+    strutil::intern_pool::id_type id;
+    EXPECT_TRUE(pool.find("token9999", id));
+    EXPECT_EQ(pool.view(id), "token9999");
+    EXPECT_FALSE(pool.find("token10000", id));
+    EXPECT_FALSE(strutil::intern_pool().find("a", id));
+
+    const auto ids = strutil::split_interned("GET,200,GET,404,200", ',', pool);
+    ASSERT_EQ(ids.size(), 5U);
+    EXPECT_EQ(ids[0], ids[2]);
+    EXPECT_EQ(ids[1], ids[4]);
+    EXPECT_EQ(pool.view(ids[3]), "404");
+    EXPECT_EQ(strutil::split_interned("a::b::a", "::", pool), (std::vector<std::uint32_t>{pool.intern("a"), pool.intern("b"), pool.intern("a")}));
+
+    strutil::intern_pool small_pool(64, 2);
+    small_pool.intern("a");
+    small_pool.intern("b");
+    EXPECT_EQ(small_pool.intern("a"), 0u);
+    EXPECT_THROW(small_pool.intern("c"), std::length_error);
+    EXPECT_EQ(small_pool.size(), 2u);
+}
+
+TEST(Splitting, sharded_intern_pool) {
+    strutil::sharded_intern_pool pool;
+    std::vector<std::vector<std::uint32_t>> ids(4);
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < ids.size(); ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < 2000; ++i) {
+                ids[t].push_back(pool.intern("key" + std::to_string(i)));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(pool.size(), 2000U);
+    for (std::size_t t = 1; t < ids.size(); ++t) {
+        EXPECT_EQ(ids[t], ids[0]);
+    }
+    for (int i = 0; i < 2000; ++i) {
+        EXPECT_EQ(pool.view(ids[0][static_cast<std::size_t>(i)]), "key" + std::to_string(i));
+    }
+    strutil::sharded_intern_pool::id_type id;
+    EXPECT_TRUE(pool.find("key42", id));
+    EXPECT_EQ(id, ids[0][42]);
+    EXPECT_EQ(strutil::split_interned("key1;key2", ';', pool), (std::vector<std::uint32_t>{ids[0][1], ids[0][2]}));
+}
+
+TEST(Splitting, sharded_intern_pool_shards) {
+    // the low bits of an id are its shard: 2000 strings reach all 16 shards
+    strutil::sharded_intern_pool pool;
+    std::unordered_set<std::uint32_t> shards;
+    for (int i = 0; i < 2000; ++i) {
+        shards.insert(pool.intern("key" + std::to_string(i)) & 15u);
+    }
+    EXPECT_EQ(shards.size(), 16U);
+
+    strutil::sharded_intern_pool single(0);
+    const auto id = single.intern("only");
+    EXPECT_EQ(single.intern("only"), id);
+    EXPECT_EQ(single.view(id), "only");
+}
+
 /*
  * Text manipulation tests
  */
@@ -476,6 +1004,40 @@ TEST(TextManip, trim_view_all_whitespace) {
 TEST(TextManip, repeat) {
     EXPECT_EQ("GoGoGoGo", strutil::repeat("Go", 4));
     EXPECT_EQ("ZZZZZZZZZZ", strutil::repeat('Z', 10));
+    EXPECT_EQ("", strutil::repeat("Go", 0));
+    EXPECT_EQ("", strutil::repeat("", 5));
+    EXPECT_EQ(std::string(3 * 1000, 'a').size(), strutil::repeat("abc", 1000).size());
+    EXPECT_EQ("abcabc", strutil::repeat("abc", 1000).substr(2997 - 3, 6));
+}
+
+TEST(TextManip, string_builder) {
+    strutil::string_builder builder;
+    builder << "x=" << 42 << ", y=" << -1.5 << ", ok=" << true << ", c=" << 'd' << ", u8=" << uint8_t{65};
+    EXPECT_EQ("x=42, y=-1.5, ok=1, c=d, u8=A", builder.view());
+    EXPECT_EQ(strutil::to_string(1.0 / 3.0), "0.333333");
+    EXPECT_EQ(strutil::to_string(1e20), "1e+20");
+
+    std::ostringstream expected;
+    expected << std::vector<int>{1, 2}.size() << ' ' << 3.25f << ' ' << 1234567.0;
+    builder.clear();
+    builder << std::vector<int>{1, 2}.size() << ' ' << 3.25f << ' ' << 1234567.0;
+    EXPECT_EQ(expected.str(), builder.str());
+
+    builder.clear();
+    builder.append('-', 3).append_repeated("ab", 100).append(std::string_view("!"));
+    EXPECT_EQ(3u + 200u + 1u, builder.size());
+    EXPECT_GE(builder.capacity(), builder.size());
+    EXPECT_EQ("---abab", builder.view().substr(0, 7));
+
+    strutil::string_builder moved(std::move(builder));
+    EXPECT_EQ(204u, moved.size());
+    EXPECT_TRUE(builder.empty());
+
+    strutil::string_builder small(8);
+    small << "short";
+    strutil::string_builder other;
+    other = std::move(small);
+    EXPECT_EQ("short", other.view());
 }
 
 TEST(TextManip, truncate) {
@@ -542,6 +1104,157 @@ TEST(TextManip, replace_all_target_empty) {
     EXPECT_EQ("This is $name and that is also $name.", str1);
 }
 
+TEST(TextManip, pmr_results) {
+    char buffer[1024];
+    std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+
+    EXPECT_EQ(std::string_view(strutil::repeat("Go", 20, &arena)), strutil::repeat("Go", 20));
+    EXPECT_EQ(std::string_view(strutil::repeat('Z', 30, &arena)), std::string(30, 'Z'));
+
+    std::pmr::string str1("This is $name and that is also $name, a long enough string.", &arena);
+    EXPECT_TRUE(strutil::replace_all(str1, "$name", "Jon Doe"));
+    EXPECT_EQ(str1, "This is Jon Doe and that is also Jon Doe, a long enough string.");
+
+    uint8_t data[] = {0x01, 0xAB, 0xFF};
+    EXPECT_EQ(strutil::to_hex_string(data, sizeof(data), true, &arena), "01ABFF");
+    EXPECT_EQ(strutil::to_hex_string(data, sizeof(data), false, &arena), "01abff");
+    EXPECT_EQ(strutil::to_hex_string(nullptr, 0, true, &arena), "");
+}
+
+TEST(TextManip, template_string) {
+    const strutil::template_string greeting("Hi {user}, {count} new {{messages}} for {user}!");
+    EXPECT_EQ(greeting.names(), (std::vector<std::string>{"user", "count"}));
+
+    std::unordered_map<std::string, std::string> values{{"user", "Ann"}, {"count", "3"}};
+    EXPECT_EQ(greeting.render(values), "Hi Ann, 3 new {messages} for Ann!");
+    EXPECT_EQ(greeting.render({"Bob", "12"}), "Hi Bob, 12 new {messages} for Bob!");
+    EXPECT_EQ(greeting.render(std::vector<std::string>{"Eve"}), "Hi Eve, {count} new {messages} for Eve!");
+
+    values.erase("count");
+    std::string out = "previous contents that are longer than the result";
+    greeting.render_into(out, values);
+    EXPECT_EQ(out, "Hi Ann, {count} new {messages} for Ann!");
+
+    const std::map<std::string, std::string_view, std::less<>> view_values{{"a", "1"}};
+    EXPECT_EQ(strutil::template_string("{a}{a}{ {} {a } {b}").render(view_values), "11{ {} {a } {b}");
+    EXPECT_EQ(strutil::template_string("").render({"x"}), "");
+    EXPECT_EQ(strutil::template_string("}}{{}}{").render({}), "}{}{");
+
+    // more names than the values kept on the stack
+    std::string many_pattern;
+    std::vector<std::string> many_values;
+    for (int i = 0; i < 40; ++i) {
+        many_pattern += "{v" + std::to_string(i) + "},";
+        many_values.push_back(std::to_string(i * i));
+    }
+    EXPECT_EQ(strutil::template_string(many_pattern).render(many_values), strutil::join(many_values, ",") + ",");
+}
+
+TEST(TextManip, transform_all) {
+    std::vector<std::string> strs{"  Hello World  ", "\tABC\n", "", "plain"};
+    strutil::transform_all(strs, strutil::ops::trim{});
+    strutil::transform_all(strs, strutil::ops::to_upper{});
+    EXPECT_EQ(strs, (std::vector<std::string>{"HELLO WORLD", "ABC", "", "PLAIN"}));
+    strutil::transform_all(strs, strutil::ops::to_lower{});
+    strutil::transform_all(strs, strutil::ops::replace_all{"l", "L"});
+    strutil::transform_all(strs, strutil::ops::truncate{6, ".."});
+    EXPECT_EQ(strs, (std::vector<std::string>{"heLL..", "abc", "", "pLain"}));
+    strutil::transform_all(strs, [](const std::string& s) { return strutil::repeat(s, 2); });
+    EXPECT_EQ(strs[1], "abcabc");
+    strutil::transform_all(strs, strutil::ops::truncate{1, "..."});
+    EXPECT_EQ(strs, (std::vector<std::string>{".", ".", "", "."}));
+
+    // several threads and a size that is not a multiple of the chunk size
+    std::vector<std::string> many;
+    for (int i = 0; i < 10007; ++i) {
+        many.push_back(" item " + std::to_string(i) + " ");
+    }
+    std::vector<std::string> expected = many;
+    for (auto& s : expected) {
+        s = strutil::to_upper(strutil::trim_copy(s));
+    }
+    const auto trim_upper = [](std::string& s) {
+        strutil::trim(s);
+        strutil::ops::to_upper{}(s);
+    };
+    strutil::transform_all(many, trim_upper, 4);
+    EXPECT_EQ(many, expected);
+
+    // an exception thrown on any thread reaches the caller once all threads are joined
+    const auto throw_on_item = [](std::string& s) {
+        if (s == "ITEM 5000" || s == "ITEM 9000") {
+            throw std::runtime_error(s);
+        }
+    };
+    EXPECT_THROW(strutil::transform_all(many, throw_on_item, 4), std::runtime_error);
+    EXPECT_THROW(strutil::transform_all(many, throw_on_item), std::runtime_error);
+}
+
+TEST(TextManip, wrap) {
+    using lines = std::vector<std::string_view>;
+    EXPECT_EQ(lines{}, strutil::wrap("", 10));
+    EXPECT_EQ((lines{"the quick", "brown fox", "jumps"}), strutil::wrap("the quick brown fox jumps", 10));
+    // runs of spaces are kept inside a line and dropped at breaks, '\n' forces a break
+    EXPECT_EQ((lines{"a  b", "c", "", "d"}), strutil::wrap("  a  b   c\n\n d\n", 4));
+    EXPECT_EQ((lines{"abcd", "efgh", "ij x"}), strutil::wrap("abcdefghij x", 4));
+    strutil::wrap_options overflow;
+    overflow.break_long_words = false;
+    EXPECT_EQ((lines{"abcdefghij", "x"}), strutil::wrap("abcdefghij x", 4, overflow));
+
+    // widths count code points, lines never cut a multi-byte sequence
+    EXPECT_EQ((lines{"\xC3\xA9t\xC3\xA9 \xC3\xA0", "\xE2\x82\xAC\xE2\x82\xAC"}),
+              strutil::wrap("\xC3\xA9t\xC3\xA9 \xC3\xA0 \xE2\x82\xAC\xE2\x82\xAC", 5));
+    strutil::wrap_options bytes;
+    bytes.utf8 = false;
+    EXPECT_EQ((lines{"\xC3\xA9t\xC3\xA9", "\xC3\xA0"}), strutil::wrap("\xC3\xA9t\xC3\xA9 \xC3\xA0", 5, bytes));
+
+    strutil::wrap_options hanging;
+    hanging.indent = "    ";
+    std::string out = "usage: ";
+    strutil::wrap_into("--level sets the logging level\n\nsee docs", 16, out, hanging);
+    EXPECT_EQ("usage: --level sets the\n    logging\n    level\n\n    see docs", out);
+
+    // one pass over large inputs
+    const std::string text = strutil::repeat("lorem ipsum dolor ", 100000);
+    const std::vector<std::string_view> wrapped = strutil::wrap(text, 80);
+    std::size_t wrapped_size = 0;
+    for (std::string_view line : wrapped) {
+        EXPECT_LE(line.size(), 80u);
+        wrapped_size += line.size();
+    }
+    // 13 words per line; every break and the trailing space drop one space
+    EXPECT_EQ((300000u + 12) / 13, wrapped.size());
+    EXPECT_EQ(text.size() - wrapped.size(), wrapped_size);
+
+    // a single multi-MB word is cut in linear time, never inside a multi-byte sequence
+    const std::string word = strutil::repeat("xxxxxxx\xC3\xA9", 500000);
+    const std::vector<std::string_view> pieces = strutil::wrap(word, 80);
+    ASSERT_EQ(4000000u / 80, pieces.size());
+    for (std::string_view piece : pieces) {
+        ASSERT_EQ(80u, strutil::utf8_length(piece));
+        ASSERT_TRUE(strutil::is_valid_utf8(piece));
+    }
+}
+
+TEST(TextManip, pad) {
+    EXPECT_EQ("   ab", strutil::pad_left("ab", 5));
+    EXPECT_EQ("ab...", strutil::pad_right("ab", 5, '.'));
+    EXPECT_EQ(" ab  ", strutil::center("ab", 5));
+    EXPECT_EQ("abcdef", strutil::center("abcdef", 5));
+    EXPECT_EQ("  \xC3\xA9t\xC3\xA9", strutil::pad_left("\xC3\xA9t\xC3\xA9", 5));
+
+    std::string table;
+    table.reserve(64);
+    const char* capacity_before = table.data();
+    for (std::string_view cell : {"id", "name", "x"}) {
+        strutil::pad_right_into(cell, 6, table);
+        table.push_back('|');
+    }
+    strutil::center_into("end", 7, table, '-');
+    EXPECT_EQ("id    |name  |x     |--end--", table);
+    EXPECT_EQ(capacity_before, table.data());
+}
+
 TEST(TextSortAscending, sorting_ascending) {
     std::vector<std::string> str1 = {"ABC", "abc", "bcd", "", "-", "  ", "123", "-100"};
     strutil::sorting_ascending(str1);
@@ -556,6 +1269,91 @@ TEST(TextSortDescending, sorting_descending) {
 
     std::vector<std::string> str2 = {"bcd", "abc", "ABC", "123", "-100", "-", "  ", ""};
     EXPECT_EQ(std::equal(str1.cbegin(), str1.cend(), str2.cbegin()), true);
+}
+
+TEST(TextSortAscending, radix_sort_matches_std_sort) {
+    std::mt19937 rng(39);
+    std::vector<std::string> input;
+    const std::string prefixes[] = {"", "http://example.com/", std::string("\0\0", 2), "\xFF\x80", "aaaaaaaaaaaaaaaaa"};
+    for (int i = 0; i < 5000; ++i) {
+        std::string str = prefixes[rng() % 5];
+        const std::size_t length = rng() % 20;
+        for (std::size_t j = 0; j < length; ++j) {
+            str.push_back(static_cast<char>("ab\0\xFFz"[rng() % 5]));
+        }
+        input.push_back(str);
+    }
+
+    std::vector<std::string> expected = input;
+    std::sort(expected.begin(), expected.end());
+    for (unsigned threads : {1u, 3u, 8u}) {
+        std::vector<std::string> sorted = input;
+        strutil::sorting_ascending(sorted, threads);
+        EXPECT_EQ(expected, sorted);
+
+        std::vector<std::string> descending = input;
+        strutil::sorting_descending(descending, threads);
+        EXPECT_TRUE(std::equal(expected.rbegin(), expected.rend(), descending.begin()));
+
+        std::vector<std::string_view> views(input.begin(), input.end());
+        strutil::sort_views(views, threads);
+        EXPECT_TRUE(std::equal(expected.begin(), expected.end(), views.begin()));
+    }
+}
+
+TEST(TextSortAscending, natural_compare) {
+    EXPECT_LT(strutil::natural_compare("file2", "file10"), 0);
+    EXPECT_GT(strutil::natural_compare("file10", "file2"), 0);
+    EXPECT_EQ(strutil::natural_compare("file10.txt", "file10.txt"), 0);
+    EXPECT_LT(strutil::natural_compare("1", "01"), 0);
+    EXPECT_LT(strutil::natural_compare("0", "00"), 0);
+    EXPECT_LT(strutil::natural_compare("a", "a1"), 0);
+    EXPECT_LT(strutil::natural_compare("a9b", "a10a"), 0);
+    EXPECT_LT(strutil::natural_compare("a1", "aa"), 0);
+    EXPECT_LT(strutil::natural_compare("99999999999999999999", "100000000000000000000"), 0);
+    EXPECT_GT(strutil::natural_compare("x\xFF", "x5"), 0);
+}
+
+TEST(TextSortAscending, sort_natural) {
+    std::vector<std::string> names = {"file10.txt", "file2.txt", "file1.txt", "file01.txt", "file", "File3.txt"};
+    strutil::sort_natural(names);
+    EXPECT_EQ(names, (std::vector<std::string>{"File3.txt", "file", "file1.txt", "file01.txt", "file2.txt", "file10.txt"}));
+
+    std::mt19937 rng(40);
+    std::vector<std::string> input;
+    for (int i = 0; i < 3000; ++i) {
+        std::string str;
+        const std::size_t length = rng() % 12;
+        for (std::size_t j = 0; j < length; ++j) {
+            str.push_back("a0019 z"[rng() % 7]);
+        }
+        input.push_back(str);
+    }
+    std::vector<std::string> expected = input;
+    std::stable_sort(expected.begin(), expected.end(),
+                     [](const std::string& lhs, const std::string& rhs) { return strutil::natural_compare(lhs, rhs) < 0; });
+    for (unsigned threads : {1u, 4u}) {
+        std::vector<std::string> sorted = input;
+        strutil::sort_natural(sorted, threads);
+        EXPECT_EQ(expected, sorted);
+    }
+}
+
+TEST(TextSortAscending, sort_ignore_case) {
+    std::vector<std::string_view> words = {"banana", "Apple", "cherry", "apple", "APPLE", "Banana", ""};
+    strutil::sort_ignore_case(words);
+    EXPECT_EQ(words, (std::vector<std::string_view>{"", "Apple", "apple", "APPLE", "banana", "Banana", "cherry"}));
+
+    std::vector<std::string> many;
+    for (int i = 0; i < 500; ++i) {
+        many.push_back(i % 2 ? "KEY" + std::to_string(i % 7) : "key" + std::to_string(i % 7));
+    }
+    std::vector<std::string> expected = many;
+    std::stable_sort(expected.begin(), expected.end(), [](const std::string& lhs, const std::string& rhs) {
+        return strutil::to_lower(lhs) < strutil::to_lower(rhs);
+    });
+    strutil::sort_ignore_case(many, 2);
+    EXPECT_EQ(expected, many);
 }
 
 TEST(TextReverseInplace, reverse_inplace) {
@@ -644,6 +1442,143 @@ TEST(BytesToString, to_binary_string) {
     EXPECT_EQ(strutil::to_binary_string(test_data2, sizeof(test_data2)), "0000000111111111");
 }
 
+TEST(BytesToString, to_base64) {
+    // RFC 4648, section 10
+    EXPECT_EQ(strutil::to_base64(""), "");
+    EXPECT_EQ(strutil::to_base64("f"), "Zg==");
+    EXPECT_EQ(strutil::to_base64("fo"), "Zm8=");
+    EXPECT_EQ(strutil::to_base64("foo"), "Zm9v");
+    EXPECT_EQ(strutil::to_base64("foob"), "Zm9vYg==");
+    EXPECT_EQ(strutil::to_base64("fooba"), "Zm9vYmE=");
+    EXPECT_EQ(strutil::to_base64("foobar"), "Zm9vYmFy");
+    EXPECT_EQ(strutil::to_base64("fo", strutil::base64_alphabet::standard, false), "Zm8");
+
+    const uint8_t high_bits[] = {0xFB, 0xFF, 0xBF};
+    EXPECT_EQ(strutil::to_base64(high_bits, sizeof(high_bits)), "+/+/");
+    EXPECT_EQ(strutil::to_base64(high_bits, sizeof(high_bits), strutil::base64_alphabet::url), "-_-_");
+
+    char out[8];
+    EXPECT_EQ(strutil::to_base64_into(high_bits, 2, out, strutil::base64_alphabet::url, false), 3);
+    EXPECT_EQ(std::string(out, 3), "-_8");
+}
+
+TEST(BytesToString, from_base64_round_trip) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> byte(0, 255);
+    for (const auto alphabet : {strutil::base64_alphabet::standard, strutil::base64_alphabet::url}) {
+        for (std::size_t size = 0; size < 300; ++size) {
+            std::vector<uint8_t> data(size);
+            for (auto& b : data) {
+                b = static_cast<uint8_t>(byte(gen));
+            }
+            for (const bool padding : {true, false}) {
+                const std::string encoded = strutil::to_base64(data.data(), data.size(), alphabet, padding);
+                ASSERT_EQ(encoded.size(), strutil::base64_encoded_size(size, padding));
+                std::size_t error_offset = 0;
+                ASSERT_EQ(strutil::from_base64(encoded, alphabet, &error_offset), data) << encoded;
+                ASSERT_EQ(error_offset, std::string_view::npos) << encoded;
+            }
+        }
+    }
+}
+
+TEST(BytesToString, from_base64_errors) {
+    const auto error_offset = [](std::string_view str, strutil::base64_alphabet alphabet = strutil::base64_alphabet::standard) {
+        std::size_t offset = 0;
+        strutil::from_base64(str, alphabet, &offset);
+        return offset;
+    };
+    const std::string foobar_bytes = "foobar";
+    const std::vector<uint8_t> foobar(foobar_bytes.begin(), foobar_bytes.end());
+
+    EXPECT_EQ(strutil::from_base64("Zm9vYmFy"), foobar);
+    EXPECT_EQ(error_offset("Zm9v YmFy"), 4);
+    EXPECT_EQ(error_offset("Zm9vY"), 4);
+    EXPECT_EQ(error_offset("Zg=a"), 2);
+    EXPECT_EQ(error_offset("Z==="), 1);
+    EXPECT_EQ(error_offset("===="), 0);
+    EXPECT_EQ(error_offset("Zg==Zg=="), 2);
+    EXPECT_EQ(error_offset("Zh=="), 1);
+    EXPECT_EQ(error_offset("Zm9="), 2);
+    EXPECT_EQ(error_offset("-_-_"), 0);
+    EXPECT_EQ(error_offset("+/+/", strutil::base64_alphabet::url), 0);
+
+    // the decoded prefix is kept up to the group holding the first error
+    std::size_t offset = 0;
+    EXPECT_EQ(strutil::from_base64("Zm9vYm!y", strutil::base64_alphabet::standard, &offset),
+              std::vector<uint8_t>(foobar.begin(), foobar.begin() + 3));
+    EXPECT_EQ(offset, 6);
+
+    // errors inside and after the blocks decoded 32 characters at a time
+    const std::string long_text = strutil::to_base64(std::string(300, 'x'));
+    for (const std::size_t pos : {0, 5, 31, 32, 63, 200, 399}) {
+        // a final '=' is padding, so the unused bits of "eHh=" are reported at its last character
+        for (const char bad : {'*', '\x80', '-', '='}) {
+            if (pos == 399 && bad == '=') {
+                EXPECT_EQ(error_offset(long_text.substr(0, 399) + bad), 398);
+                continue;
+            }
+            std::string broken = long_text;
+            broken[pos] = bad;
+            EXPECT_EQ(error_offset(broken), pos) << pos << ' ' << bad;
+        }
+        std::string broken_url = strutil::to_base64(std::string(300, '\xFB'), strutil::base64_alphabet::url);
+        broken_url[pos] = '+';
+        EXPECT_EQ(error_offset(broken_url, strutil::base64_alphabet::url), pos) << pos;
+    }
+}
+
+TEST(BytesToString, escape_c) {
+    EXPECT_EQ(strutil::escape_c(""), "");
+    EXPECT_EQ(strutil::escape_c("plain text"), "plain text");
+    EXPECT_EQ(strutil::escape_c(std::string("a\\b\n\0\x7F\xFF", 7)), "a\\\\b\\n\\0\\x7F\\xFF");
+
+    // the special byte lands at every position of the 64- and 16-byte blocks and in the scalar tail
+    const std::string clean(150, 'c');
+    for (std::size_t pos = 0; pos < clean.size(); ++pos) {
+        std::string input = clean;
+        input[pos] = '\t';
+        EXPECT_EQ(strutil::escape_c(input), clean.substr(0, pos) + "\\t" + clean.substr(pos + 1)) << pos;
+    }
+    EXPECT_EQ(strutil::escape_c("\x01\x02" + clean), "\\x01\\x02" + clean);
+}
+
+TEST(BytesToString, unescape_c) {
+    EXPECT_EQ(strutil::unescape_c(""), "");
+    EXPECT_EQ(strutil::unescape_c("\\a\\\"\\'\\?\\x4a\\x4B"), "\a\"'?JK");
+
+    std::string all_bytes;
+    for (int ch = 0; ch < 256; ++ch) {
+        all_bytes.push_back(static_cast<char>(ch));
+    }
+    std::size_t error_offset = 0;
+    EXPECT_EQ(strutil::unescape_c(strutil::escape_c(all_bytes), &error_offset), all_bytes);
+    EXPECT_EQ(error_offset, std::string_view::npos);
+
+    EXPECT_EQ(strutil::unescape_c("ab\\qcd", &error_offset), "ab");
+    EXPECT_EQ(error_offset, 2);
+    EXPECT_EQ(strutil::unescape_c("ab\\", &error_offset), "ab");
+    EXPECT_EQ(error_offset, 2);
+    EXPECT_EQ(strutil::unescape_c("\\n\\x4", &error_offset), "\n");
+    EXPECT_EQ(error_offset, 2);
+    EXPECT_EQ(strutil::unescape_c("\\xg0", &error_offset), "");
+    EXPECT_EQ(error_offset, 0);
+}
+
+TEST(BytesToString, escape_json) {
+    EXPECT_EQ(strutil::escape_json(""), "");
+    EXPECT_EQ(strutil::escape_json("say \"hi\"\\"), "say \\\"hi\\\"\\\\");
+    EXPECT_EQ(strutil::escape_json(std::string("\b\f\n\r\t\0\x1F", 7)), "\\b\\f\\n\\r\\t\\u0000\\u001f");
+    EXPECT_EQ(strutil::escape_json("\x7F caf\xC3\xA9"), "\x7F caf\xC3\xA9");
+
+    const std::string clean(150, 'j');
+    for (std::size_t pos = 0; pos < clean.size(); ++pos) {
+        std::string input = clean;
+        input[pos] = '"';
+        EXPECT_EQ(strutil::escape_json(input), clean.substr(0, pos) + "\\\"" + clean.substr(pos + 1)) << pos;
+    }
+}
+
 TEST(Checks, is_alphanumeric_positive) {
     const std::vector<std::string> alphanumeric{
         "",
@@ -675,3 +1610,372 @@ TEST(Checks, is_alphanumeric_negative) {
         ASSERT_FALSE(strutil::is_alphanumeric(s)) << s;
     }
 }
+
+/*
+ * Similarity tests
+ */
+
+namespace {
+std::size_t naive_levenshtein(const std::string& a, const std::string& b) {
+    std::vector<std::size_t> row(b.size() + 1);
+    for (std::size_t j = 0; j <= b.size(); ++j) {
+        row[j] = j;
+    }
+    for (std::size_t i = 1; i <= a.size(); ++i) {
+        std::size_t diagonal = row[0];
+        row[0] = i;
+        for (std::size_t j = 1; j <= b.size(); ++j) {
+            const std::size_t above = row[j];
+            row[j] = std::min({row[j] + 1, row[j - 1] + 1, diagonal + (a[i - 1] == b[j - 1] ? 0 : 1)});
+            diagonal = above;
+        }
+    }
+    return row[b.size()];
+}
+} // namespace
+
+TEST(Similarity, levenshtein_distance) {
+    EXPECT_EQ(strutil::levenshtein_distance("", ""), 0U);
+    EXPECT_EQ(strutil::levenshtein_distance("", "abc"), 3U);
+    EXPECT_EQ(strutil::levenshtein_distance("kitten", "sitting"), 3U);
+    EXPECT_EQ(strutil::levenshtein_distance("flaw", "lawn"), 2U);
+    EXPECT_EQ(strutil::levenshtein_distance("same", "same"), 0U);
+
+    // single- and multi-word patterns against the textbook dynamic programming
+    std::mt19937 rng(42);
+    const auto random_string = [&](std::size_t max_size) {
+        std::string result(rng() % max_size, 'a');
+        for (auto& c : result) {
+            c = static_cast<char>('a' + rng() % 4);
+        }
+        return result;
+    };
+    for (int i = 0; i < 300; ++i) {
+        const std::string a = random_string(200);
+        std::string b = a;
+        for (auto edits = rng() % 20; edits > 0 && !b.empty(); --edits) {
+            b[rng() % b.size()] = static_cast<char>('a' + rng() % 4);
+            if (rng() % 3 == 0) {
+                b.erase(rng() % b.size(), 1);
+            }
+        }
+        b += random_string(5);
+        ASSERT_EQ(strutil::levenshtein_distance(a, b), naive_levenshtein(a, b)) << a << " / " << b;
+        ASSERT_EQ(strutil::levenshtein_distance(b, a), naive_levenshtein(a, b));
+        const std::size_t expected = naive_levenshtein(a, b);
+        ASSERT_TRUE(strutil::within_distance(a, b, expected));
+        ASSERT_TRUE(expected == 0 || !strutil::within_distance(a, b, expected - 1));
+        const std::string unrelated = random_string(200);
+        ASSERT_EQ(strutil::levenshtein_distance(a, unrelated), naive_levenshtein(a, unrelated));
+    }
+}
+
+TEST(Similarity, within_distance) {
+    EXPECT_TRUE(strutil::within_distance("kitten", "sitting", 3));
+    EXPECT_FALSE(strutil::within_distance("kitten", "sitting", 2));
+    EXPECT_FALSE(strutil::within_distance("a", "abcdef", 4));
+    EXPECT_TRUE(strutil::within_distance("", "", 0));
+
+    const std::string long1 = strutil::repeat("abcdefghij", 20);
+    std::string long2 = long1;
+    long2[5] = 'x';
+    long2[150] = 'y';
+    EXPECT_TRUE(strutil::within_distance(long1, long2, 2));
+    EXPECT_FALSE(strutil::within_distance(long1, long2, 1));
+    EXPECT_FALSE(strutil::within_distance(long1, strutil::repeat("z", 200), 10));
+}
+
+TEST(Similarity, fuzzy_matcher) {
+    const std::vector<std::string> commands = {"commit", "checkout", "cherry-pick", "clone", "status", "stash", "config", "comit"};
+    const strutil::fuzzy_matcher matcher("comitt");
+    EXPECT_EQ(matcher.distance("commit"), 2U);
+    EXPECT_TRUE(matcher.within("comit", 1));
+
+    const auto matches = matcher.top_k(commands, 3);
+    ASSERT_EQ(matches.size(), 3U);
+    EXPECT_EQ(commands[matches[0].index], "comit");
+    EXPECT_EQ(matches[0].distance, 1U);
+    EXPECT_EQ(commands[matches[1].index], "commit");
+    EXPECT_EQ(matches[1].distance, 2U);
+
+    EXPECT_TRUE(matcher.top_k(commands, 3, 0).empty());
+    EXPECT_EQ(matcher.top_k(commands, 10, 2).size(), 2U);
+
+    // multi-threaded scan returns the same matches
+    std::vector<std::string> dictionary;
+    for (int i = 0; i < 5000; ++i) {
+        dictionary.push_back("word" + std::to_string(i));
+    }
+    const strutil::fuzzy_matcher word_matcher("word4242x");
+    const auto single = word_matcher.top_k(dictionary, 5);
+    const auto parallel = word_matcher.top_k(dictionary, 5, std::string_view::npos, 4);
+    ASSERT_EQ(single.size(), 5U);
+    ASSERT_EQ(parallel.size(), 5U);
+    EXPECT_EQ(dictionary[single[0].index], "word4242");
+    for (std::size_t i = 0; i < single.size(); ++i) {
+        EXPECT_EQ(single[i].index, parallel[i].index);
+        EXPECT_EQ(single[i].distance, parallel[i].distance);
+    }
+}
+
+TEST(Matching, glob_pattern) {
+    const strutil::glob_pattern logs("logs/*/error-?.txt");
+    EXPECT_EQ(logs.literal_prefix(), "logs/");
+    EXPECT_TRUE(logs.matches("logs/web/error-1.txt"));
+    EXPECT_TRUE(logs.matches("logs/a/b/error-x.txt"));
+    EXPECT_FALSE(logs.matches("logs/web/error-10.txt"));
+    EXPECT_FALSE(logs.matches("logs/error-1.txt"));
+    EXPECT_FALSE(logs.matches("var/logs/web/error-1.txt"));
+
+    EXPECT_TRUE(strutil::glob_match("", ""));
+    EXPECT_TRUE(strutil::glob_match("", "*"));
+    EXPECT_TRUE(strutil::glob_match("anything", "*"));
+    EXPECT_FALSE(strutil::glob_match("", "?"));
+    EXPECT_TRUE(strutil::glob_match("abc", "abc"));
+    EXPECT_FALSE(strutil::glob_match("abcd", "abc"));
+    EXPECT_TRUE(strutil::glob_match("aXbXc", "a*b*c"));
+    EXPECT_TRUE(strutil::glob_match("abcbc", "*bc"));
+    EXPECT_TRUE(strutil::glob_match("mississippi", "m*iss*ppi"));
+    EXPECT_FALSE(strutil::glob_match("mississippi", "m*iss*iss*iss*"));
+    EXPECT_TRUE(strutil::glob_match("ab", "a**b"));
+    EXPECT_FALSE(strutil::glob_match("aba", "a*ba*ba"));
+
+    EXPECT_TRUE(strutil::glob_match("file7.log", "file[0-9].log"));
+    EXPECT_FALSE(strutil::glob_match("fileX.log", "file[0-9].log"));
+    EXPECT_TRUE(strutil::glob_match("fileX.log", "file[!0-9].log"));
+    EXPECT_TRUE(strutil::glob_match("a]", "a[]]"));
+    EXPECT_TRUE(strutil::glob_match("a-", "a[x-]"));
+    EXPECT_TRUE(strutil::glob_match("a[b", "a[b"));      // unterminated class is literal
+    EXPECT_TRUE(strutil::glob_match("a*b", "a\\*b"));   // escaped star
+    EXPECT_FALSE(strutil::glob_match("axb", "a\\*b"));
+    EXPECT_TRUE(strutil::glob_match("topic.eu.cpu", "topic.*.[cm][pe][um]"));
+
+    // pathological input for backtracking matchers stays linear
+    EXPECT_FALSE(strutil::glob_match(std::string(10000, 'a'), strutil::repeat("a*", 50) + "b"));
+    // middle segments that keep failing late, with literal, '?' and class heads and wider than 64 atoms
+    const std::string many_a(1000000, 'a');
+    EXPECT_FALSE(strutil::glob_match(many_a, "*" + std::string(500, 'a') + "b*"));
+    EXPECT_FALSE(strutil::glob_match(many_a, "*?" + std::string(40, 'a') + "b*"));
+    EXPECT_FALSE(strutil::glob_match(many_a, "*[a-c]" + std::string(100, 'a') + "[bc]*"));
+    EXPECT_TRUE(strutil::glob_match(many_a + "b", "*[a-c]" + std::string(100, 'a') + "[bc]*"));
+    EXPECT_TRUE(strutil::glob_match("xaabaabaaby", "x*a?baab*y"));
+    EXPECT_TRUE(strutil::glob_match("x" + std::string(70, 'a') + "bz", "x*" + std::string(64, 'a') + "?b*z"));
+}
+
+TEST(Matching, glob_set) {
+    strutil::glob_set set;
+    EXPECT_EQ(set.add("logs/*.txt"), 0U);
+    EXPECT_EQ(set.add("logs/error-*"), 1U);
+    EXPECT_EQ(set.add("*.txt"), 2U);
+    EXPECT_EQ(set.add("metrics/cpu"), 3U);
+    EXPECT_EQ(set.add("lo?s/*"), 4U);
+    EXPECT_EQ(set.size(), 5U);
+
+    EXPECT_EQ(set.matching("logs/error-1.txt"), (std::vector<std::size_t>{0, 1, 2, 4}));
+    EXPECT_EQ(set.matching("metrics/cpu"), (std::vector<std::size_t>{3}));
+    EXPECT_EQ(set.matching("readme.txt"), (std::vector<std::size_t>{2}));
+    EXPECT_TRUE(set.matching("metrics/mem").empty());
+    EXPECT_TRUE(set.matches_any("lots/x"));
+    EXPECT_FALSE(set.matches_any("metrics"));
+    EXPECT_FALSE(strutil::glob_set().matches_any(""));
+
+    strutil::glob_set many;
+    for (int i = 0; i < 1000; ++i) {
+        many.add("service" + std::to_string(i) + "/*/error-?.log");
+    }
+    EXPECT_EQ(many.matching("service42/host/error-1.log"), (std::vector<std::size_t>{42}));
+    EXPECT_FALSE(many.matches_any("service42/host/warn-1.log"));
+}
+
+TEST(Hashing, hash) {
+    // values are part of the contract: identical on every platform, with or without SSE2
+    EXPECT_EQ(0x0409638ee2bde459ull, strutil::hash(""));
+    EXPECT_EQ(0x0e24bbd9f93f532dull, strutil::hash("hello"));
+    EXPECT_EQ(0x97ab046234adad55ull, strutil::hash(std::string(1000, 'x')));
+    EXPECT_EQ(0x0ec0d4c3eedd7771ull, strutil::hash("hello", 42));
+    EXPECT_NE(strutil::hash("hello", 1), strutil::hash("hello", 2));
+
+    // every prefix length exercises a different path; prefixes of one string must not collide
+    std::string text;
+    std::unordered_set<std::uint64_t> seen;
+    for (int i = 0; i < 1200; ++i) {
+        EXPECT_EQ(strutil::hash(text), strutil::hash(std::string(text)));
+        seen.insert(strutil::hash(text));
+        text.push_back(static_cast<char>('a' + i % 7));
+    }
+    EXPECT_EQ(1200u, seen.size());
+}
+
+TEST(Hashing, seeded_stripe_keys) {
+    // Two 256-byte inputs that differ only in word 1 of stripes 0 and 1. With the unseeded stripe keys
+    // 0x9417034723148989 and 0xDD555950609DFE03 the keyed products are zero and the data sums are equal,
+    // so they would collide under every seed; seeding the keys must separate them.
+    const auto make = [](std::uint64_t word0, std::uint64_t word1) {
+        std::string input(256, '\0');
+        for (int i = 0; i < 8; ++i) {
+            input[8 + i] = static_cast<char>(word0 >> (8 * i));
+            input[72 + i] = static_cast<char>(word1 >> (8 * i));
+        }
+        return input;
+    };
+    const std::string first = make(0x9417034723148989ull, 0xDD555950609DFE02ull);
+    const std::string second = make(0x9417034723148988ull, 0xDD555950609DFE03ull);
+    for (std::uint64_t seed : {0ull, 1ull, 0xdeadbeefull, 0x123456789abcdefull}) {
+        EXPECT_NE(strutil::hash(first, seed), strutil::hash(second, seed)) << seed;
+    }
+    EXPECT_NE(strutil::hash(first, 1), strutil::hash(first, 2));
+}
+
+TEST(Hashing, hasher_heterogeneous_lookup) {
+    std::unordered_map<std::string, int, strutil::hasher, std::equal_to<>> counts(16, strutil::hasher(7));
+    for (std::string_view token : strutil::split("a,b,a,c,a", ',')) {
+        ++counts[std::string(token)];
+    }
+    EXPECT_EQ(3, counts["a"]);
+    EXPECT_EQ(strutil::hasher(7)(std::string("abc")), strutil::hasher(7)(std::string_view("abc")));
+    EXPECT_EQ(strutil::hash("abc", 7), strutil::hasher(7)("abc"));
+#if defined(__cpp_lib_generic_unordered_lookup)
+    const std::string_view key = "b";
+    ASSERT_NE(counts.end(), counts.find(key));
+    EXPECT_EQ(1, counts.find(key)->second);
+#endif
+}
+
+TEST(Dispatch, kernels_match_scalar) {
+    std::mt19937 generator(42);
+    std::string text;
+    for (int i = 0; i < 3000; ++i) {
+        const char* pieces[] = {"Hello, ", "wORLD", "\xC3\xA9t\xC3\xA9 ", "\"q\"", "\\", "\t", ",", "\n", "x", "\x7F", "\xE2\x82\xAC"};
+        text += pieces[generator() % (sizeof(pieces) / sizeof(pieces[0]))];
+    }
+    std::string invalid = text;
+    invalid[invalid.size() - 37] = '\xFF';
+    std::string bytes;
+    for (int i = 0; i < 1000; ++i) {
+        bytes.push_back(static_cast<char>(generator()));
+    }
+    std::string bad_base64 = strutil::to_base64(bytes);
+    bad_base64[700] = '*';
+
+    // every dispatched kernel, summarized as strings
+    const auto run_all = [&]() {
+        std::vector<std::string> results;
+        results.push_back(std::to_string(strutil::utf8_length(text)));
+        results.push_back(std::to_string(strutil::is_valid_utf8(text)));
+        results.push_back(std::to_string(strutil::find_invalid_utf8(invalid)));
+        results.push_back(strutil::to_lower_utf8(text));
+        results.push_back(strutil::to_upper_utf8(text));
+        results.push_back(std::to_string(strutil::compare_ignore_case_utf8(strutil::to_upper_utf8(text), text)));
+        results.push_back(std::to_string(strutil::compare_ignore_case_utf8(invalid, text)));
+        results.push_back(std::to_string(strutil::find_ignore_case(text, "WORLD\\")));
+        results.push_back(std::to_string(strutil::find_ignore_case(text, "\xE2\x82\xAC\xE2\x82\xAC", 100)));
+        strutil::csv_reader reader(text);
+        std::vector<std::string_view> fields;
+        std::size_t field_count = 0;
+        while (reader.next_record(fields)) {
+            field_count += fields.size();
+            results.push_back(strutil::join(fields, "|"));
+        }
+        results.push_back(std::to_string(field_count));
+        results.push_back(std::to_string(strutil::hash(text)));
+        results.push_back(std::to_string(strutil::hash(std::string_view(text).substr(3, 1001), 9)));
+        results.push_back(strutil::to_base64(bytes, strutil::base64_alphabet::url, false));
+        const std::vector<uint8_t> decoded = strutil::from_base64(strutil::to_base64(bytes));
+        results.push_back(std::string(decoded.begin(), decoded.end()));
+        std::size_t error_offset = 0;
+        strutil::from_base64(bad_base64, strutil::base64_alphabet::standard, &error_offset);
+        results.push_back(std::to_string(error_offset));
+        results.push_back(strutil::escape_c(text));
+        results.push_back(strutil::escape_c(bytes));
+        results.push_back(strutil::escape_json(text));
+        return results;
+    };
+
+    const strutil::isa_level detected = strutil::detected_isa();
+    ASSERT_EQ(strutil::isa_level::scalar, strutil::set_isa(strutil::isa_level::scalar));
+    const std::vector<std::string> expected = run_all();
+    for (auto level = static_cast<unsigned>(strutil::isa_level::sse2); level <= static_cast<unsigned>(detected); ++level) {
+        strutil::set_isa(static_cast<strutil::isa_level>(level));
+        SCOPED_TRACE(std::string(strutil::isa_name(strutil::active_isa())));
+        EXPECT_EQ(expected, run_all());
+    }
+
+    EXPECT_EQ(detected, strutil::set_isa(strutil::isa_level::avx512));
+    EXPECT_TRUE(strutil::set_isa("scalar"));
+    EXPECT_EQ(strutil::isa_level::scalar, strutil::active_isa());
+    EXPECT_FALSE(strutil::set_isa("sse5"));
+    EXPECT_EQ(strutil::isa_level::scalar, strutil::active_isa());
+    for (const strutil::kernel_dispatch& kernel : strutil::dispatch_report()) {
+        EXPECT_EQ(strutil::isa_level::scalar, kernel.level);
+    }
+    strutil::set_isa(detected);
+    std::vector<std::string_view> names;
+    for (const strutil::kernel_dispatch& kernel : strutil::dispatch_report()) {
+        EXPECT_LE(kernel.level, detected);
+        names.push_back(kernel.name);
+    }
+    EXPECT_EQ(names, (std::vector<std::string_view>{"ascii_case", "ascii_prefix_length", "base64_decode", "base64_encode",
+                                                    "compare_ignore_case_utf8", "csv_reader", "escape_c", "escape_json",
+                                                    "find_ignore_case", "hash", "utf8_length"}));
+}
+
+TEST(Stats, stats_snapshot) {
+    const auto find_stats = [](std::string_view name) {
+        for (const strutil::function_stats& stats : strutil::stats_snapshot()) {
+            if (stats.name == name) {
+                return stats;
+            }
+        }
+        return strutil::function_stats{name};
+    };
+    const strutil::function_stats split_before = find_stats("split");
+    const strutil::function_stats join_before = find_stats("join");
+    const strutil::function_stats preview_before = find_stats("preview");
+
+    strutil::set_stats_sampling(1);
+    const std::vector<std::string> tokens = strutil::split("a,bc,,def", ',');
+    EXPECT_EQ("a-bc--def", strutil::join(tokens, "-"));
+    EXPECT_EQ("x\\ny", strutil::preview("x\ny"));
+    std::thread([] { strutil::split("1,2", ','); }).join();
+    strutil::set_stats_sampling(0);
+    const strutil::function_stats split_into_before = find_stats("split_into");
+    std::vector<std::string> reused;
+    strutil::split_into("x;yz", ';', reused);
+    strutil::split_lines_into("l1\nl2", reused);
+
+    const strutil::function_stats split_after = find_stats("split");
+    const strutil::function_stats join_after = find_stats("join");
+    const strutil::function_stats preview_after = find_stats("preview");
+    if (!strutil::stats_enabled()) {
+        EXPECT_TRUE(strutil::stats_snapshot().empty());
+        return;
+    }
+    // the second split ran on a thread that has exited since
+    EXPECT_EQ(2u, split_after.calls - split_before.calls);
+    EXPECT_EQ(9u + 3u, split_after.input_bytes - split_before.input_bytes);
+    EXPECT_EQ(6u + 2u, split_after.output_bytes - split_before.output_bytes);
+    EXPECT_EQ(2u, split_after.sampled_calls - split_before.sampled_calls);
+    std::uint64_t histogram_total = 0;
+    for (std::uint64_t count : split_after.latency_histogram) {
+        histogram_total += count;
+    }
+    EXPECT_EQ(split_after.sampled_calls, histogram_total);
+
+    const strutil::function_stats split_into_after = find_stats("split_into");
+    EXPECT_EQ(1u, split_into_after.calls - split_into_before.calls);
+    EXPECT_EQ(4u, split_into_after.input_bytes - split_into_before.input_bytes);
+    EXPECT_EQ(3u, split_into_after.output_bytes - split_into_before.output_bytes);
+    EXPECT_LE(1u, find_stats("split_lines_into").calls);
+
+    EXPECT_EQ(1u, join_after.calls - join_before.calls);
+    EXPECT_EQ(6u, join_after.input_bytes - join_before.input_bytes);
+    EXPECT_EQ(9u, join_after.output_bytes - join_before.output_bytes);
+    EXPECT_EQ(1u, preview_after.calls - preview_before.calls);
+    EXPECT_EQ(3u, preview_after.input_bytes - preview_before.input_bytes);
+    EXPECT_EQ(4u, preview_after.output_bytes - preview_before.output_bytes);
+
+    const std::vector<strutil::function_stats> snapshot = strutil::stats_snapshot();
+    EXPECT_TRUE(std::is_sorted(snapshot.begin(), snapshot.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.name < rhs.name;
+    }));
+}
@@ -0,0 +1,71 @@
+/**
+ * Measures how strutil::transform_all scales with the number of threads.
+ *
+ * Transforms one million short strings with ops::trim followed by ops::to_upper and with a heavier
+ * replace_all, once per thread count from 1 up to the number of hardware threads, and prints the
+ * best of five runs and the speedup over one thread.
+ *
+ * Build and run from the repository root:
+ *   g++ -std=c++17 -O2 -I include tools/bench_transform_all.cpp -pthread -o bench_transform_all
+ *   ./bench_transform_all [strings]
+ */
+#include <strutil.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+std::vector<std::string> make_input(std::size_t count) {
+    std::vector<std::string> strs;
+    strs.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        strs.push_back("  key_" + std::to_string(i) + " = some value, with text " + std::to_string(i * 7) + "  ");
+    }
+    return strs;
+}
+
+template<typename Op>
+double best_milliseconds(const std::vector<std::string>& input, const Op& op, unsigned threads) {
+    double best = 1e300;
+    for (int run = 0; run < 5; ++run) {
+        std::vector<std::string> strs = input;
+        const auto start = std::chrono::steady_clock::now();
+        strutil::transform_all(strs, op, threads);
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+template<typename Op>
+void run(const char* name, const std::vector<std::string>& input, const Op& op) {
+    const unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+    double single = 0;
+    std::printf("%s\n", name);
+    for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+        const double ms = best_milliseconds(input, op, threads);
+        if (threads == 1) {
+            single = ms;
+        }
+        std::printf("  %3u threads: %9.2f ms  %5.2fx\n", threads, ms, single / ms);
+    }
+}
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    const std::vector<std::string> input = make_input(count);
+    std::printf("%zu strings, %u hardware threads\n", count, std::thread::hardware_concurrency());
+
+    run("trim + to_upper", input, [](std::string& s) {
+        strutil::ops::trim{}(s);
+        strutil::ops::to_upper{}(s);
+    });
+    run("replace_all(\"e\", \"E\")", input, strutil::ops::replace_all{"e", "E"});
+    return 0;
+}
@@ -0,0 +1,109 @@
+#!/usr/bin/env python3
+"""
+Generates the two-level simple case mapping tables used by the UTF-8 case
+conversion functions of include/strutil/case.h (detail::CASE_* arrays).
+
+Mappings:
+  - lower / upper: the simple lowercase and uppercase mapping fields (13 and 12)
+                   of UnicodeData.txt
+  - fold:          simple case folding (CaseFolding.txt status C + S), from the
+                   Unicode database bundled with the running Python
+
+UnicodeData.txt must be of the same Unicode version as the Python database.
+
+Usage: python3 tools/generate_case_tables.py UnicodeData.txt > tables.txt
+and paste the output over the generated block in include/strutil/case.h.
+"""
+import sys
+import unicodedata
+
+BLOCK_SIZE = 64
+PER_LINE = 32
+
+
+def simple_mapping(convert):
+    mapping = {}
+    for cp in range(0x110000):
+        if 0xD800 <= cp <= 0xDFFF:
+            continue
+        result = convert(chr(cp))
+        if len(result) == 1 and ord(result) != cp:
+            mapping[cp] = ord(result)
+    return mapping
+
+
+def unicode_data_mappings(path):
+    """Returns the simple lowercase and uppercase mappings of UnicodeData.txt.
+
+    Unlike str.lower() / str.upper(), these are defined for code points whose full
+    mapping expands, e.g. U+0130 lowercases to U+0069 and U+1FB3 uppercases to U+1FBC.
+    """
+    lower = {}
+    upper = {}
+    with open(path, encoding="utf-8") as data:
+        for line in data:
+            fields = line.rstrip("\n").split(";")
+            if len(fields) != 15:
+                continue
+            cp = int(fields[0], 16)
+            if fields[12]:
+                upper[cp] = int(fields[12], 16)
+            if fields[13]:
+                lower[cp] = int(fields[13], 16)
+    return lower, upper
+
+
+def simple_fold(c):
+    folded = c.casefold()
+    if len(folded) == 1:
+        return folded
+    # full folding expands (e.g. U+1E9E), the simple folding is the lowercase mapping if it is a single code point
+    lowered = c.lower()
+    return lowered if len(lowered) == 1 else c
+
+
+def emit_array(ctype, name, values):
+    print(f"inline constexpr {ctype} {name}[{len(values)}] = {{")
+    for i in range(0, len(values), PER_LINE):
+        print("    " + ", ".join(str(v) for v in values[i:i + PER_LINE]) + ",")
+    print("};")
+
+
+def main():
+    if len(sys.argv) != 2:
+        sys.exit("usage: generate_case_tables.py UnicodeData.txt")
+    lower, upper = unicode_data_mappings(sys.argv[1])
+    tables = [
+        ("LOWER", lower),
+        ("UPPER", upper),
+        ("FOLD", simple_mapping(simple_fold)),
+    ]
+    limit = max(max(m) for _, m in tables) + 1
+    block_count = (limit + BLOCK_SIZE - 1) // BLOCK_SIZE
+
+    deltas = {0: 0}
+    blocks = {}
+    stage1 = {}
+    for name, mapping in tables:
+        stage1[name] = []
+        for b in range(block_count):
+            base = b * BLOCK_SIZE
+            block = []
+            for cp in range(base, base + BLOCK_SIZE):
+                delta = mapping.get(cp, cp) - cp
+                block.append(deltas.setdefault(delta, len(deltas)))
+            stage1[name].append(blocks.setdefault(tuple(block), len(blocks)))
+
+    assert len(blocks) <= 256 and len(deltas) <= 256
+
+    print(f"// Generated by tools/generate_case_tables.py from Unicode {unicodedata.unidata_version}, do not edit.")
+    print(f"inline constexpr char32_t CASE_TABLE_LIMIT = {limit};")
+    print(f"inline constexpr unsigned CASE_BLOCK_SHIFT = {BLOCK_SIZE.bit_length() - 1};")
+    for name, _ in tables:
+        emit_array("std::uint8_t", f"CASE_{name}_BLOCKS", stage1[name])
+    emit_array("std::uint8_t", "CASE_BLOCK_DELTAS", [i for block in blocks for i in block])
+    emit_array("std::int32_t", "CASE_DELTAS", list(deltas))
+
+
+if __name__ == "__main__":
+    main()